@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Also built as benchmark-atomic_shared_ptr_load_split, with _STD_ATOMIC_SHARED_PTR_LOCK_FREE_LOAD=1.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+using namespace std;
+
+namespace {
+    struct config {
+        size_t generation;
+        int values[14];
+    };
+
+    atomic<shared_ptr<const config>> current_config{make_shared<const config>()};
+
+    // Thread 0 publishes a new config every writer_period iterations; every other thread only reads.
+    template <size_t writer_period>
+    void bm_many_readers_one_writer(benchmark::State& state) {
+        const bool is_writer = state.thread_index() == 0;
+        size_t generation    = 0;
+        for (auto _ : state) {
+            if (is_writer) {
+                if (++generation % writer_period == 0) {
+                    current_config.store(make_shared<const config>(config{generation, {}}));
+                }
+            } else {
+                auto snapshot = current_config.load();
+                benchmark::DoNotOptimize(snapshot->values[0]);
+            }
+        }
+    }
+
+    void bm_readers_only(benchmark::State& state) {
+        for (auto _ : state) {
+            auto snapshot = current_config.load();
+            benchmark::DoNotOptimize(snapshot->values[0]);
+        }
+    }
+} // unnamed namespace
+
+BENCHMARK(bm_readers_only)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bm_many_readers_one_writer<64>)->ThreadRange(2, 64)->UseRealTime();
+BENCHMARK(bm_many_readers_one_writer<4096>)->ThreadRange(2, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <semaphore>
+#include <thread>
+
+using namespace std;
+
+// Each iteration is one round trip: the benchmark thread hands a turn to a partner thread and waits to get it back.
+
+void bm_atomic_wait_ping_pong(benchmark::State& state) {
+    atomic<int> turn{0};
+
+    jthread partner{[&turn] {
+        for (;;) {
+            turn.wait(0, memory_order_acquire);
+            if (turn.load(memory_order_relaxed) == 2) {
+                return;
+            }
+
+            turn.store(0, memory_order_release);
+            turn.notify_one();
+        }
+    }};
+
+    for (auto _ : state) {
+        turn.store(1, memory_order_release);
+        turn.notify_one();
+        turn.wait(1, memory_order_acquire);
+    }
+
+    turn.store(2, memory_order_release);
+    turn.notify_one();
+}
+
+void bm_binary_semaphore_ping_pong(benchmark::State& state) {
+    binary_semaphore ping{0};
+    binary_semaphore pong{0};
+    atomic<bool> done{false};
+
+    jthread partner{[&] {
+        for (;;) {
+            ping.acquire();
+            if (done.load(memory_order_relaxed)) {
+                return;
+            }
+
+            pong.release();
+        }
+    }};
+
+    for (auto _ : state) {
+        ping.release();
+        pong.acquire();
+    }
+
+    done.store(true, memory_order_relaxed);
+    ping.release();
+}
+
+void bm_counting_semaphore_ping_pong(benchmark::State& state) {
+    counting_semaphore<> ping{0};
+    counting_semaphore<> pong{0};
+    atomic<bool> done{false};
+
+    jthread partner{[&] {
+        for (;;) {
+            ping.acquire();
+            if (done.load(memory_order_relaxed)) {
+                return;
+            }
+
+            pong.release();
+        }
+    }};
+
+    for (auto _ : state) {
+        ping.release();
+        pong.acquire();
+    }
+
+    done.store(true, memory_order_relaxed);
+    ping.release();
+}
+
+BENCHMARK(bm_atomic_wait_ping_pong)->UseRealTime();
+BENCHMARK(bm_binary_semaphore_ping_pong)->UseRealTime();
+BENCHMARK(bm_counting_semaphore_ping_pong)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <barrier>
+#include <benchmark/benchmark.h>
+
+using namespace std;
+
+namespace {
+    // Every iteration is one barrier phase in which all threads arrive and wait.
+    // The framework synchronizes the threads when entering and leaving the loop,
+    // so thread 0 can create and destroy the shared barrier outside of it.
+    template <class Barrier>
+    void bm_phase_latency(benchmark::State& state) {
+        static Barrier* shared_barrier = nullptr;
+        if (state.thread_index() == 0) {
+            shared_barrier = new Barrier(state.threads());
+        }
+
+        for (auto _ : state) {
+            shared_barrier->arrive_and_wait();
+        }
+
+        if (state.thread_index() == 0) {
+            delete shared_barrier;
+            shared_barrier = nullptr;
+        }
+    }
+} // unnamed namespace
+
+BENCHMARK(bm_phase_latency<barrier<>>)->ThreadRange(2, 128)->UseRealTime();
+BENCHMARK(bm_phase_latency<stdext::combining_barrier<>>)->ThreadRange(2, 128)->UseRealTime();
+
+BENCHMARK_MAIN();
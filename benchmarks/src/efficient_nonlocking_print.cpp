@@ -40,4 +40,27 @@ void BM_vprint_complex(benchmark::State& state) {
 BENCHMARK(BM_vprint_complex<&std::vprint_unicode>);
 BENCHMARK(BM_vprint_complex<&std::vprint_unicode_buffered>);
 
+// One stdext::print_batch for the whole run: stdout is locked, and checked for being a console, just once.
+void BM_print_batch(benchmark::State& state) {
+    stdext::print_batch batch{stdout};
+    for (auto _ : state) {
+        batch.print("Hello cool I am going to print as unicode\n");
+    }
+}
+BENCHMARK(BM_print_batch);
+
+void BM_print_batch_complex(benchmark::State& state) {
+    const int i           = 42;
+    const std::string str = "Hello world!!!!!!!!!!!!!!!!!!!!!!!!";
+    const double f        = -902.16283758;
+    const std::pair<int, double> p{16, 2.073f};
+    stdext::print_batch batch{stdout};
+    for (auto _ : state) {
+        batch.print("Hello cool I am going to print as unicode!! {:X}, {}, {:a}, "
+                    "I am a big string, lots of words, multiple {} formats\n",
+            i, str, f, p);
+    }
+}
+BENCHMARK(BM_print_batch_complex);
+
 BENCHMARK_MAIN();
@@ -3,7 +3,10 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <string>
 #include <system_error>
 
 void symlink_status(benchmark::State& state) {
@@ -20,4 +23,44 @@ void symlink_status(benchmark::State& state) {
 
 BENCHMARK(symlink_status);
 
+// Creates a directory of 2000 small files on first use, and removes it when the program exits.
+const std::filesystem::path& populated_directory() {
+    struct populated {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "stl_benchmark_filesystem";
+
+        populated() {
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directory(path);
+            for (int i = 0; i < 2000; ++i) {
+                std::ofstream{path / ("file" + std::to_string(i) + ".txt")} << i;
+            }
+        }
+
+        ~populated() {
+            std::error_code ec;
+            std::filesystem::remove_all(path, ec);
+        }
+    };
+
+    static const populated directory;
+    return directory.path;
+}
+
+void directory_iteration(benchmark::State& state) {
+    const auto& path = populated_directory();
+
+    for (auto _ : state) {
+        std::uintmax_t total_size = 0;
+        for (const auto& entry : std::filesystem::directory_iterator{path}) {
+            total_size += entry.file_size(); // cached by the iteration, so no additional query
+        }
+
+        benchmark::DoNotOptimize(total_size);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2000);
+}
+
+BENCHMARK(directory_iteration);
+
 BENCHMARK_MAIN();
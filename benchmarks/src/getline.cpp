@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+namespace {
+    template <class CharT>
+    basic_string<CharT> make_lines(const size_t line_length) {
+        basic_string<CharT> text;
+        for (size_t line = 0; line < (1 << 20) / (line_length + 1); ++line) {
+            for (size_t i = 0; i < line_length; ++i) {
+                text.push_back(static_cast<CharT>('a' + i % 26));
+            }
+
+            text.push_back(CharT{'\n'});
+        }
+
+        return text;
+    }
+
+    template <class CharT>
+    void bm_getline(benchmark::State& state) {
+        const auto text = make_lines<CharT>(static_cast<size_t>(state.range(0)));
+        basic_string<CharT> line;
+        for (auto _ : state) {
+            basic_istringstream<CharT> stream{text};
+            while (getline(stream, line)) {
+                benchmark::DoNotOptimize(line);
+            }
+        }
+
+        state.SetBytesProcessed(static_cast<long long>(state.iterations() * text.size() * sizeof(CharT)));
+    }
+
+    template <class CharT>
+    void bm_istream_getline(benchmark::State& state) {
+        const auto text = make_lines<CharT>(static_cast<size_t>(state.range(0)));
+        CharT buffer[1024];
+        for (auto _ : state) {
+            basic_istringstream<CharT> stream{text};
+            while (stream.getline(buffer, size(buffer))) {
+                benchmark::DoNotOptimize(buffer);
+            }
+        }
+
+        state.SetBytesProcessed(static_cast<long long>(state.iterations() * text.size() * sizeof(CharT)));
+    }
+
+    template <class CharT>
+    void bm_ignore(benchmark::State& state) {
+        const auto text = make_lines<CharT>(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            basic_istringstream<CharT> stream{text};
+            while (stream.ignore(numeric_limits<streamsize>::max(), CharT{'\n'})) {
+                benchmark::DoNotOptimize(stream.gcount());
+            }
+        }
+
+        state.SetBytesProcessed(static_cast<long long>(state.iterations() * text.size() * sizeof(CharT)));
+    }
+
+    void common_args(benchmark::Benchmark* bm) {
+        bm->Arg(8)->Arg(80)->Arg(800);
+    }
+} // unnamed namespace
+
+BENCHMARK(bm_getline<char>)->Apply(common_args);
+BENCHMARK(bm_getline<wchar_t>)->Apply(common_args);
+BENCHMARK(bm_istream_getline<char>)->Apply(common_args);
+BENCHMARK(bm_istream_getline<wchar_t>)->Apply(common_args);
+BENCHMARK(bm_ignore<char>)->Apply(common_args);
+BENCHMARK(bm_ignore<wchar_t>)->Apply(common_args);
+
+BENCHMARK_MAIN();
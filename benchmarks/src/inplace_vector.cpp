@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <inplace_vector>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+template <class T>
+T make_value(const size_t i) {
+    if constexpr (is_same_v<T, string>) {
+        return string(static_cast<size_t>(8 + i % 8), 'x');
+    } else {
+        return static_cast<T>(i);
+    }
+}
+
+template <class T, size_t N>
+void bm_inplace_vector_push_back(benchmark::State& state) {
+    for (auto _ : state) {
+        inplace_vector<T, N> v;
+        for (size_t i = 0; i != N; ++i) {
+            v.push_back(make_value<T>(i));
+        }
+
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+template <class T, size_t N>
+void bm_vector_reserve_push_back(benchmark::State& state) {
+    for (auto _ : state) {
+        vector<T> v;
+        v.reserve(N);
+        for (size_t i = 0; i != N; ++i) {
+            v.push_back(make_value<T>(i));
+        }
+
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+template <class T, size_t N>
+void bm_inplace_vector_insert_front(benchmark::State& state) {
+    for (auto _ : state) {
+        inplace_vector<T, N> v;
+        for (size_t i = 0; i != N; ++i) {
+            v.insert(v.begin(), make_value<T>(i));
+        }
+
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+template <class T, size_t N>
+void bm_vector_reserve_insert_front(benchmark::State& state) {
+    for (auto _ : state) {
+        vector<T> v;
+        v.reserve(N);
+        for (size_t i = 0; i != N; ++i) {
+            v.insert(v.begin(), make_value<T>(i));
+        }
+
+        benchmark::DoNotOptimize(v);
+    }
+}
+
+BENCHMARK(bm_inplace_vector_push_back<int, 16>);
+BENCHMARK(bm_vector_reserve_push_back<int, 16>);
+BENCHMARK(bm_inplace_vector_push_back<int, 256>);
+BENCHMARK(bm_vector_reserve_push_back<int, 256>);
+BENCHMARK(bm_inplace_vector_push_back<string, 16>);
+BENCHMARK(bm_vector_reserve_push_back<string, 16>);
+
+BENCHMARK(bm_inplace_vector_insert_front<int, 64>);
+BENCHMARK(bm_vector_reserve_insert_front<int, 64>);
+BENCHMARK(bm_inplace_vector_insert_front<string, 64>);
+BENCHMARK(bm_vector_reserve_insert_front<string, 64>);
+
+BENCHMARK_MAIN();
@@ -14,6 +14,26 @@ void locate_zone(benchmark::State& state) {
     }
 }
 
+void locate_zone_link(benchmark::State& state) {
+    const auto& db = std::chrono::get_tzdb();
+    for (auto _ : state) {
+        for (const auto& l : db.links) {
+            auto res = db.locate_zone(l.name());
+            benchmark::DoNotOptimize(res);
+        }
+    }
+}
+
+void current_zone(benchmark::State& state) {
+    const auto& db = std::chrono::get_tzdb();
+    for (auto _ : state) {
+        auto res = db.current_zone();
+        benchmark::DoNotOptimize(res);
+    }
+}
+
 BENCHMARK(locate_zone);
+BENCHMARK(locate_zone_link);
+BENCHMARK(current_zone);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <sstream>
+#include <syncstream>
+
+using namespace std;
+
+namespace {
+    constexpr size_t max_threads = 64;
+
+    // a sink that discards everything, so the benchmark measures osyncstream and not the sink
+    class null_buf : public streambuf {
+    protected:
+        int_type overflow(const int_type ch) override {
+            return traits_type::not_eof(ch);
+        }
+
+        streamsize xsputn(const char*, const streamsize count) override {
+            return count;
+        }
+    };
+
+    // Every thread logs one line per iteration through a temporary osyncstream, the usual idiom.
+    // With shared_sink set, all threads write to one sink; otherwise each thread has its own.
+    template <bool shared_sink>
+    void bm_log_line(benchmark::State& state) {
+        static null_buf sinks[max_threads];
+        null_buf& sink = sinks[shared_sink ? 0 : static_cast<size_t>(state.thread_index())];
+        ostream os{&sink};
+        int line = 0;
+        for (auto _ : state) {
+            osyncstream{os} << "thread " << state.thread_index() << " line " << ++line << '\n';
+        }
+    }
+} // unnamed namespace
+
+BENCHMARK(bm_log_line<false>)->ThreadRange(1, max_threads)->UseRealTime();
+BENCHMARK(bm_log_line<true>)->ThreadRange(1, max_threads)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -23,6 +23,25 @@ void BM_lexically_normal(benchmark::State& state) {
     }
 }
 
+void BM_lexically_relative(benchmark::State& state) {
+    using namespace std::literals;
+    static constexpr std::wstring_view args[3][2]{
+        {LR"(C:\Program Files\Microsoft Visual Studio\2022\Community\Common7\IDE\VC\Snippets)"sv,
+            LR"(C:\Program Files\Microsoft Visual Studio\2022\Community)"sv},
+        {LR"(C:\Program Files\Microsoft Visual Studio\2022\Community)"sv,
+            LR"(C:\Program Files\Microsoft Visual Studio\2022\Community\Common7\IDE\VC\Snippets)"sv},
+        {LR"(src\compiler\backend\codegen\emit.cpp)"sv, LR"(src\compiler\frontend\parser\.\lexer)"sv},
+    };
+
+    const auto index = state.range(0);
+    const std::filesystem::path p(args[index][0]);
+    const std::filesystem::path base(args[index][1]);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.lexically_relative(base));
+    }
+}
+
 BENCHMARK(BM_lexically_normal)->DenseRange(0, 4, 1);
+BENCHMARK(BM_lexically_relative)->DenseRange(0, 2, 1);
 
 BENCHMARK_MAIN();
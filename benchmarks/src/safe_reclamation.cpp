@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Compares read-mostly snapshot publication with atomic<shared_ptr>, hazard pointers, and RCU.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <hazard_pointer>
+#include <memory>
+#include <mutex>
+#include <rcu>
+
+using namespace std;
+
+namespace {
+    struct config {
+        size_t generation;
+        int values[14];
+    };
+
+    struct hp_config : hazard_pointer_obj_base<hp_config> {
+        explicit hp_config(const size_t generation_) : generation(generation_) {}
+
+        size_t generation;
+        int values[14]{};
+    };
+
+    struct rcu_config : rcu_obj_base<rcu_config> {
+        explicit rcu_config(const size_t generation_) : generation(generation_) {}
+
+        size_t generation;
+        int values[14]{};
+    };
+
+    atomic<shared_ptr<const config>> shared_config{make_shared<const config>()};
+    atomic<hp_config*> hp_current{new hp_config{0}};
+    atomic<rcu_config*> rcu_current{new rcu_config{0}};
+
+    // In the many_readers_one_writer benchmarks, thread 0 publishes a new config every writer_period iterations
+    // and every other thread only reads.
+
+    template <size_t writer_period>
+    void bm_shared_ptr(benchmark::State& state) {
+        const bool is_writer = state.thread_index() == 0 && state.threads() > 1;
+        size_t generation    = 0;
+        for (auto _ : state) {
+            if (is_writer) {
+                if (++generation % writer_period == 0) {
+                    shared_config.store(make_shared<const config>(config{generation, {}}));
+                }
+            } else {
+                auto snapshot = shared_config.load();
+                benchmark::DoNotOptimize(snapshot->values[0]);
+            }
+        }
+    }
+
+    template <size_t writer_period>
+    void bm_hazard_pointer(benchmark::State& state) {
+        const bool is_writer = state.thread_index() == 0 && state.threads() > 1;
+        size_t generation    = 0;
+        hazard_pointer hp    = make_hazard_pointer();
+        for (auto _ : state) {
+            if (is_writer) {
+                if (++generation % writer_period == 0) {
+                    hp_current.exchange(new hp_config{generation})->retire();
+                }
+            } else {
+                const auto snapshot = hp.protect(hp_current);
+                benchmark::DoNotOptimize(snapshot->values[0]);
+                hp.reset_protection();
+            }
+        }
+    }
+
+    template <size_t writer_period>
+    void bm_rcu(benchmark::State& state) {
+        const bool is_writer = state.thread_index() == 0 && state.threads() > 1;
+        size_t generation    = 0;
+        for (auto _ : state) {
+            if (is_writer) {
+                if (++generation % writer_period == 0) {
+                    rcu_current.exchange(new rcu_config{generation})->retire();
+                }
+            } else {
+                scoped_lock guard{rcu_default_domain()};
+                benchmark::DoNotOptimize(rcu_current.load(memory_order_acquire)->values[0]);
+            }
+        }
+    }
+} // unnamed namespace
+
+BENCHMARK(bm_shared_ptr<64>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bm_hazard_pointer<64>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bm_rcu<64>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bm_shared_ptr<4096>)->ThreadRange(2, 64)->UseRealTime();
+BENCHMARK(bm_hazard_pointer<4096>)->ThreadRange(2, 64)->UseRealTime();
+BENCHMARK(bm_rcu<4096>)->ThreadRange(2, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+
+using namespace std;
+
+namespace {
+    template <class Mutex>
+    struct guarded_table {
+        Mutex mtx;
+        int values[64]{};
+    };
+
+    // Every thread reads under a shared lock; with a nonzero writer_period, thread 0 also writes that often.
+    template <class Mutex, size_t writer_period>
+    void bm_read_mostly(benchmark::State& state) {
+        static guarded_table<Mutex> table;
+        const bool is_writer = writer_period != 0 && state.thread_index() == 0;
+        size_t iteration     = 0;
+        for (auto _ : state) {
+            if (is_writer && ++iteration % writer_period == 0) {
+                lock_guard lock{table.mtx};
+                ++table.values[iteration % 64];
+            } else {
+                shared_lock lock{table.mtx};
+                benchmark::DoNotOptimize(table.values[iteration % 64]);
+            }
+        }
+    }
+} // unnamed namespace
+
+BENCHMARK(bm_read_mostly<shared_mutex, 0>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bm_read_mostly<stdext::distributed_shared_mutex, 0>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bm_read_mostly<shared_mutex, 1024>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bm_read_mostly<stdext::distributed_shared_mutex, 1024>)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+#include <optional>
+#include <stop_token>
+
+using namespace std;
+
+namespace {
+    struct no_op {
+        void operator()() const noexcept {}
+    };
+
+    // Every thread registers and deregisters short-lived callbacks on one shared stop state.
+    // With nested set, they're destroyed in reverse order of creation; otherwise the older one goes first.
+    template <bool nested>
+    void bm_register_deregister(benchmark::State& state) {
+        static stop_source source;
+        const auto token = source.get_token();
+        for (auto _ : state) {
+            optional<stop_callback<no_op>> older{in_place, token, no_op{}};
+            stop_callback<no_op> newer{token, no_op{}};
+            if constexpr (!nested) {
+                older.reset();
+            }
+        }
+    }
+} // unnamed namespace
+
+BENCHMARK(bm_register_deregister<true>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(bm_register_deregister<false>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
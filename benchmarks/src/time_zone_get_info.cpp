@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace {
+    // timestamps spread over a few years, like a log being converted to local time
+    std::vector<sys_seconds> make_timestamps() {
+        std::mt19937_64 gen{1729};
+        std::uniform_int_distribution<std::int64_t> dist{0, 3 * 365 * 86400};
+        std::vector<sys_seconds> result(4096);
+        for (auto& t : result) {
+            t = sys_days{2022y / January / 1} + seconds{dist(gen)};
+        }
+
+        return result;
+    }
+
+    const auto timestamps = make_timestamps();
+
+    const time_zone* zone() {
+        return get_tzdb().locate_zone("America/Los_Angeles");
+    }
+
+    void bm_get_info(benchmark::State& state) {
+        const auto tz = zone();
+        for (auto _ : state) {
+            for (const auto& t : timestamps) {
+                auto info = tz->get_info(t);
+                benchmark::DoNotOptimize(info);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<long long>(state.iterations() * timestamps.size()));
+    }
+
+    void bm_to_local(benchmark::State& state) {
+        const auto tz = zone();
+        for (auto _ : state) {
+            for (const auto& t : timestamps) {
+                auto local = tz->to_local(t);
+                benchmark::DoNotOptimize(local);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<long long>(state.iterations() * timestamps.size()));
+    }
+
+    void bm_to_sys(benchmark::State& state) {
+        const auto tz = zone();
+        for (auto _ : state) {
+            for (const auto& t : timestamps) {
+                auto sys = tz->to_sys(local_seconds{t.time_since_epoch()}, choose::earliest);
+                benchmark::DoNotOptimize(sys);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<long long>(state.iterations() * timestamps.size()));
+    }
+} // namespace
+
+BENCHMARK(bm_get_info);
+BENCHMARK(bm_to_local);
+BENCHMARK(bm_to_sys);
+BENCHMARK(bm_to_local)->Threads(8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -90,6 +90,7 @@
 #include <fstream>
 #include <functional>
 #include <generator>
+#include <inplace_vector>
 #include <iomanip>
 #include <ios>
 #include <iosfwd>
@@ -140,8 +141,10 @@
 #include <condition_variable>
 #include <execution>
 #include <future>
+#include <hazard_pointer>
 #include <latch>
 #include <mutex>
+#include <rcu>
 #include <semaphore>
 #include <shared_mutex>
 #include <stop_token>
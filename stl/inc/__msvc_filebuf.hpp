@@ -11,6 +11,17 @@
 #include <cstdio>
 #include <streambuf>
 
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+#include <xfilesystem_abi.h>
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
+// The DLL's standard stream buffers are used only through basic_streambuf, but the static library's share inline
+// member functions and the vtable with the program, so the static library records this setting too, except where
+// basic_filebuf isn't used at all.
+#if !defined(_CRTBLD) || (!defined(_DLL) && !defined(_STL_FILEBUF_LAYOUT_UNUSED))
+#pragma detect_mismatch("_STD_FILEBUF_LARGE_BLOCK_IO", _STL_STRINGIZE(_STD_FILEBUF_LARGE_BLOCK_IO))
+#endif // ^^^ !defined(_CRTBLD) || (!defined(_DLL) && !defined(_STL_FILEBUF_LAYOUT_UNUSED)) ^^^
+
 #pragma pack(push, _CRT_PACKING)
 #pragma warning(push, _STL_WARNING_LEVEL)
 #pragma warning(disable : _STL_DISABLED_WARNINGS)
@@ -185,6 +196,11 @@ public:
             bool _Closef_sav                        = _Closef;
             bool _Set_eback_sav                     = _Mysb::eback() == &_Mychar;
             bool _Set_eback_live                    = _Mysb::gptr() == &_Mychar;
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+            _Elem* _Map_first_sav                   = _Map_first;
+            _Elem* _Map_last_sav                    = _Map_last;
+            bool _Binary_sav                        = _Binary;
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
 
             _Elem* _Pfirst0 = _Mysb::pbase();
             _Elem* _Pnext0  = _Mysb::pptr();
@@ -195,6 +211,12 @@ public:
 
             // reinitialize *this
             _Init(_Right._Myfile, _Right._Myfile ? _Openfl : _Newfl);
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+            if (_Right._Map_first) {
+                _Mysb::_Init(); // the get area is in the mapped file, not the C stream's buffer
+            }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
             _Mysb::setp(_Right.pbase(), _Right.pptr(), _Right.epptr());
             if (_Right.eback() != &_Right._Mychar) {
                 _Mysb::setg(_Right.eback(), _Right.gptr(), _Right.egptr());
@@ -208,9 +230,20 @@ public:
             _State     = _Right._State;
             _Wrotesome = _Right._Wrotesome;
             _Closef    = _Right._Closef;
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+            _Map_first = _Right._Map_first;
+            _Map_last  = _Right._Map_last;
+            _Binary    = _Right._Binary;
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
 
             // reinitialize _Right
             _Right._Init(_Myfile_sav, _Myfile_sav ? _Openfl : _Newfl);
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+            if (_Map_first_sav) {
+                _Right._Mysb::_Init();
+            }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
             _Right.setp(_Pfirst0, _Pnext0, _Pend);
             if (!_Set_eback_sav) {
                 _Right.setg(_Gfirst0, _Gnext0, _Gend);
@@ -224,6 +257,11 @@ public:
             _Right._State     = _State_sav;
             _Right._Wrotesome = _Wrotesome_sav;
             _Right._Closef    = _Closef_sav;
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+            _Right._Map_first = _Map_first_sav;
+            _Right._Map_last  = _Map_last_sav;
+            _Right._Binary    = _Binary_sav;
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
 
             // swap ancillary data
             _STD swap(_Set_eback, _Right._Set_eback);
@@ -260,6 +298,9 @@ public:
 
         _Init(_File, _Openfl);
         _Initcvt(_STD use_facet<_Cvt>(_Mysb::getloc()));
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+        _Init_large_block_io(_Mode);
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
         return this; // open succeeded
     }
 
@@ -287,6 +328,9 @@ public:
 
         _Init(_File, _Openfl);
         _Initcvt(_STD use_facet<_Cvt>(_Mysb::getloc()));
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+        _Init_large_block_io(_Mode);
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
         return this; // open succeeded
     }
 
@@ -315,6 +359,11 @@ public:
         basic_filebuf* _Ans;
         if (_Myfile) { // put any homing sequence and close file
             _Reset_back(); // revert from _Mychar buffer
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+            if (_Map_first) {
+                __std_fs_unmap_file(_Map_first);
+            }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
 
             _Ans = this;
             if (!_Endwrite()) {
@@ -413,6 +462,10 @@ protected:
             return _Traits::not_eof(_Meta);
         } else if (!_Myfile || _Traits::eq_int_type(_Traits::eof(), _Meta)) {
             return _Traits::eof(); // no open C stream or EOF, fail
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+        } else if (_Map_first) {
+            return _Traits::eof(); // the mapped file is read-only, so only the element read can be put back
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
         } else if (!_Pcvt && _Ungetc(_Traits::to_char_type(_Meta), _Myfile)) {
             return _Meta; // no facet and unget succeeded, return
         } else if (_Mysb::gptr() != &_Mychar) { // putback to _Mychar
@@ -445,6 +498,20 @@ protected:
             return _Traits::eof(); // no open C stream, fail
         }
 
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+        if (_Map_first) {
+            const auto _Next = _Mysb::gptr();
+            if (_Next != _Map_last) { // move the get area on to the next part of the mapped file
+                _Set_mapped_get_area(_Next);
+                return _Traits::to_int_type(*_Mysb::_Gninc());
+            }
+
+            if (!_Leave_mapped_mode()) {
+                return _Traits::eof();
+            }
+        }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
         _Reset_back(); // revert from _Mychar buffer
         if (!_Pcvt) { // no codecvt facet, just get it
             _Elem _Ch;
@@ -516,8 +583,29 @@ protected:
                 _Mysb::gbump(static_cast<int>(_Read_size));
             }
 
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+            if (_Map_first && 0 < _Count_s) { // copy the rest straight from the mapped file
+                const auto _Next      = _Mysb::gptr();
+                const auto _Read_size = (_STD min) (_Count_s, static_cast<size_t>(_Map_last - _Next));
+                _Traits::copy(_Ptr, _Next, _Read_size);
+                _Ptr += _Read_size;
+                _Count_s -= _Read_size;
+                _Set_mapped_get_area(_Next + _Read_size);
+                if (_Count_s == 0 || !_Leave_mapped_mode()) {
+                    return static_cast<streamsize>(_Start_count - _Count_s);
+                }
+            }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
             if (_Myfile) { // open C stream, attempt read
                 _Reset_back(); // revert from _Mychar buffer
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+                if (_Binary) { // without newline translation, fread can read large blocks straight into _Ptr
+                    _Count_s -= _CSTD fread(_Ptr, sizeof(_Elem), _Count_s, _Myfile);
+                    return static_cast<streamsize>(_Start_count - _Count_s);
+                }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
                 // process in 4k - 1 chunks to avoid tripping over fread's clobber-the-end behavior when
                 // doing \r\n -> \n translation
                 constexpr size_t _Read_size = 4095; // _INTERNAL_BUFSIZ - 1
@@ -575,6 +663,28 @@ protected:
         ios_base::openmode = ios_base::in | ios_base::out) override { // change position by _Off
         fpos_t _Fileposition;
 
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+        if (_Map_first) {
+            const auto _Size  = static_cast<off_type>(_Map_last - _Map_first);
+            off_type _New_off = _Off;
+            if (_Way == ios_base::cur) {
+                _New_off += static_cast<off_type>(_Mysb::gptr() - _Map_first);
+            } else if (_Way == ios_base::end) {
+                _New_off += _Size;
+            }
+
+            if (0 <= _New_off && _New_off <= _Size) {
+                _Set_mapped_get_area(_Map_first + _New_off);
+                return pos_type{_State, _New_off};
+            }
+
+            // the C stream is left at the current position, so it can seek relative to it
+            if (!_Leave_mapped_mode()) {
+                return pos_type{off_type{-1}};
+            }
+        }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
         if (_Mysb::gptr() == &_Mychar // something putback
             && _Way == ios_base::cur // a relative seek
             && !_Pcvt) { // not converting
@@ -595,6 +705,20 @@ protected:
         // change position to _Pos
         off_type _Off = static_cast<off_type>(_Pos);
 
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+        if (_Map_first) {
+            if (0 <= _Off && _Off <= static_cast<off_type>(_Map_last - _Map_first)) {
+                _Set_mapped_get_area(_Map_first + _Off);
+                _State = _Pos.state();
+                return pos_type{_State, _Off};
+            }
+
+            if (!_Leave_mapped_mode()) {
+                return pos_type{off_type{-1}};
+            }
+        }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
         if (!_Myfile || !_Endwrite() || _CSTD fsetpos(_Myfile, &_Off) != 0) {
             return pos_type{off_type{-1}}; // report failure
         }
@@ -614,6 +738,12 @@ protected:
 
         const size_t _Size = static_cast<size_t>(_Count) * sizeof(_Elem);
 
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+        if (_Map_first) {
+            return this; // reads come from the mapped file, so there is no buffer to replace
+        }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
         if (!_Myfile || _CSTD setvbuf(_Myfile, reinterpret_cast<char*>(_Buffer), _Mode, _Size) != 0) {
             return nullptr; // failed
         }
@@ -661,6 +791,11 @@ protected:
         _Myfile = _File;
         _State  = _Stinit;
         _Pcvt   = nullptr; // pointer to codecvt facet
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+        _Map_first = nullptr;
+        _Map_last  = nullptr;
+        _Binary    = false;
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
     }
 
     bool _Endwrite() { // put shift to initial conversion state, as needed
@@ -704,6 +839,12 @@ protected:
         if (_Newcvt.always_noconv()) {
             _Pcvt = nullptr; // nothing to do
         } else { // set up for nontrivial codecvt facet
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+            if (_Map_first) { // the facet reads through the C stream
+                (void) _Leave_mapped_mode();
+            }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
+
             _Pcvt = _STD addressof(_Newcvt);
             _Mysb::_Init(); // reset any buffering
         }
@@ -733,6 +874,51 @@ private:
 
     _Elem* _Set_eback; // saves eback() during one-element putback
     _Elem* _Set_egptr; // saves egptr()
+
+#if _STD_FILEBUF_LARGE_BLOCK_IO
+    _Elem* _Map_first; // the mapped file, when reading from it instead of the C stream (otherwise null)
+    _Elem* _Map_last; // end of the mapped file
+    bool _Binary; // true if opened in binary mode, so reads aren't translated
+
+    void _Init_large_block_io(const ios_base::openmode _Mode) noexcept { // after opening the C stream in _Mode
+        if constexpr (sizeof(_Elem) == 1) {
+            _Binary = (_Mode & ios_base::binary) != 0;
+            if (!_Binary || _Pcvt || (_Mode & (ios_base::out | ios_base::app | ios_base::ate)) != 0) {
+                return; // only map files opened just for binary input
+            }
+
+            constexpr unsigned long long _Min_mapped_size = 64 * 1024; // smaller files are read faster than mapped
+            const void* _View;
+            size_t _View_size;
+            if (__std_fs_map_file_for_reading(_CSTD _fileno(_Myfile), _Min_mapped_size, &_View, &_View_size)
+                == __std_win_error::_Success) {
+                _Map_first = static_cast<_Elem*>(const_cast<void*>(_View)); // never written, see pbackfail()
+                _Map_last  = _Map_first + _View_size;
+                _Mysb::_Init(); // the get area is in the mapped file, not the C stream's buffer
+                _Set_mapped_get_area(_Map_first);
+            }
+        } else {
+            (void) _Mode;
+        }
+    }
+
+    void _Set_mapped_get_area(_Elem* const _Next) noexcept {
+        // the get area's size is stored in an int, so it covers at most 1 GiB of the mapped file at a time
+        constexpr size_t _Max_get_area = size_t{1} << 30;
+        const auto _Remaining          = static_cast<size_t>(_Map_last - _Next);
+        _Mysb::setg(_Map_first, _Next, _Next + (_Remaining < _Max_get_area ? _Remaining : _Max_get_area));
+    }
+
+    _NODISCARD bool _Leave_mapped_mode() noexcept {
+        // switch to reading the C stream from the same position, which also sees anything appended since mapping
+        const auto _Offset     = static_cast<long long>(_Mysb::gptr() - _Map_first);
+        const bool _Binary_sav = _Binary;
+        __std_fs_unmap_file(_Map_first);
+        _Init(_Myfile, _Openfl);
+        _Binary = _Binary_sav;
+        return _CSTD _fseeki64(_Myfile, _Offset, SEEK_SET) == 0;
+    }
+#endif // _STD_FILEBUF_LARGE_BLOCK_IO
 };
 
 _EXPORT_STD template <class _Elem, class _Traits>
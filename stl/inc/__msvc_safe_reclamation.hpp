@@ -0,0 +1,44 @@
+// __msvc_safe_reclamation.hpp internal header
+
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef __MSVC_SAFE_RECLAMATION_HPP
+#define __MSVC_SAFE_RECLAMATION_HPP
+#include <yvals_core.h>
+#if _STL_COMPILER_PREPROCESSOR
+
+#pragma pack(push, _CRT_PACKING)
+#pragma warning(push, _STL_WARNING_LEVEL)
+#pragma warning(disable : _STL_DISABLED_WARNINGS)
+_STL_DISABLE_CLANG_WARNINGS
+#pragma push_macro("new")
+#undef new
+
+extern "C" {
+// A retired object, linked into a list of retired objects until it can be reclaimed.
+// The node is embedded in hazard_pointer_obj_base and rcu_obj_base, so retiring such objects never allocates.
+struct __std_reclaimable {
+    __std_reclaimable* _Next;
+    const void* _Object; // the address that hazard pointers protect
+    void(__stdcall* _Reclaim)(__std_reclaimable* _Retired) _NOEXCEPT_FNPTR;
+};
+
+// Returns a pointer to a std::atomic<const void*> that is owned by the caller until released, or null on failure.
+_NODISCARD void* __stdcall __std_hazard_pointer_acquire() noexcept;
+void __stdcall __std_hazard_pointer_release(void* _Slot) noexcept;
+void __stdcall __std_hazard_pointer_retire(__std_reclaimable* _Retired) noexcept;
+
+void __stdcall __std_rcu_read_lock() noexcept;
+void __stdcall __std_rcu_read_unlock() noexcept;
+void __stdcall __std_rcu_retire(__std_reclaimable* _Retired) noexcept;
+void __stdcall __std_rcu_synchronize() noexcept;
+void __stdcall __std_rcu_barrier() noexcept;
+} // extern "C"
+
+#pragma pop_macro("new")
+_STL_RESTORE_CLANG_WARNINGS
+#pragma warning(pop)
+#pragma pack(pop)
+#endif // _STL_COMPILER_PREPROCESSOR
+#endif // __MSVC_SAFE_RECLAMATION_HPP
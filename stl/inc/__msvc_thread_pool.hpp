@@ -0,0 +1,62 @@
+// __msvc_thread_pool.hpp internal header
+
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef __MSVC_THREAD_POOL_HPP
+#define __MSVC_THREAD_POOL_HPP
+#include <yvals_core.h>
+#if _STL_COMPILER_PREPROCESSOR
+#include <cstddef>
+
+#pragma pack(push, _CRT_PACKING)
+#pragma warning(push, _STL_WARNING_LEVEL)
+#pragma warning(disable : _STL_DISABLED_WARNINGS)
+_STL_DISABLE_CLANG_WARNINGS
+#pragma push_macro("new")
+#undef new
+
+extern "C" {
+// A unit of work for the STL thread pool. The submitter owns the task and must keep it alive until _Run is called.
+struct __std_thread_pool_task {
+    void(__stdcall* _Run)(__std_thread_pool_task* _Task) _NOEXCEPT_FNPTR;
+};
+
+struct __std_thread_pool_statistics {
+    size_t _Threads;
+    size_t _Queued;
+    size_t _Active;
+    unsigned long long _Completed;
+    unsigned long long _Steals;
+};
+
+// Sets the number of worker threads that the pool starts with; 0 selects thread::hardware_concurrency().
+// Returns false if the pool has already started.
+_NODISCARD bool __stdcall __std_thread_pool_set_threads(unsigned int _Threads) noexcept;
+
+// Queues _Task, starting the pool if necessary. Returns false if the pool could not start any threads.
+_NODISCARD bool __stdcall __std_thread_pool_submit(__std_thread_pool_task* _Task) noexcept;
+
+void __stdcall __std_thread_pool_get_statistics(__std_thread_pool_statistics* _Stats) noexcept;
+
+// A callback registered on a future's shared state, queued on the thread pool when the state becomes ready.
+struct __std_future_continuation {
+    __std_thread_pool_task _Task;
+    __std_future_continuation* _Next;
+};
+
+// These are called with the shared state's mutex held, which orders registration against readiness.
+// Registration returns false if memory for the table entry could not be allocated.
+_NODISCARD bool __stdcall __std_future_add_continuation(
+    const void* _State, __std_future_continuation* _Continuation) noexcept;
+
+// Removes the continuations registered on _State, returning them linked in registration order.
+_NODISCARD __std_future_continuation* __stdcall __std_future_take_continuations(const void* _State) noexcept;
+} // extern "C"
+
+#pragma pop_macro("new")
+_STL_RESTORE_CLANG_WARNINGS
+#pragma warning(pop)
+#pragma pack(pop)
+#endif // _STL_COMPILER_PREPROCESSOR
+#endif // __MSVC_THREAD_POOL_HPP
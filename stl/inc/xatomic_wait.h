@@ -29,9 +29,13 @@ int __stdcall __std_atomic_wait_direct(
 void __stdcall __std_atomic_notify_one_direct(const void* _Storage) noexcept;
 void __stdcall __std_atomic_notify_all_direct(const void* _Storage) noexcept;
 
+// Returns how many pause iterations, up to _Max_spins, are worth spending before a direct wait on _Storage;
+// adapted to how long earlier direct waits on nearby addresses blocked.
+unsigned long __stdcall __std_atomic_wait_spin_limit(const void* _Storage, unsigned long _Max_spins) noexcept;
+
 // The "indirect" functions are used when the size is not 1, 2, 4, or 8; these notionally wait on another value which is
-// of one of those sizes whose value changes upon notify, hence "indirect". (As of 2020-07-24, this always uses the
-// fallback SRWLOCK and CONDITION_VARIABLE implementation but that is not contractual.)
+// of one of those sizes whose value changes upon notify, hence "indirect". (This waits on a sequence word in a queue
+// kept for each address being waited on, but that is not contractual.)
 using _Atomic_wait_indirect_equal_callback_t = bool(__stdcall*)(
     const void* _Storage, void* _Comparand, size_t _Size, void* _Param) _NOEXCEPT_FNPTR;
 
@@ -40,6 +44,16 @@ int __stdcall __std_atomic_wait_indirect(const void* _Storage, void* _Comparand,
 void __stdcall __std_atomic_notify_one_indirect(const void* _Storage) noexcept;
 void __stdcall __std_atomic_notify_all_indirect(const void* _Storage) noexcept;
 
+// Counters for indirect waits, which share a table of queues hashed by address.
+struct __std_atomic_wait_statistics {
+    unsigned long long _Waits;
+    unsigned long long _Collisions;
+    unsigned long long _Spurious_wakeups;
+    size_t _Queues;
+};
+
+void __stdcall __std_atomic_wait_get_statistics(__std_atomic_wait_statistics* _Stats) noexcept;
+
 } // extern "C"
 
 #pragma pop_macro("new")
@@ -367,6 +367,13 @@ _NODISCARD __std_win_error __stdcall __std_fs_resize_file(_In_z_ const wchar_t*
 
 _NODISCARD __std_win_error __stdcall __std_fs_space(_In_z_ const wchar_t* _Target, _Out_ uintmax_t* _Available,
     _Out_ uintmax_t* _Total_bytes, _Out_ uintmax_t* _Free_bytes) noexcept;
+
+// maps the whole of the disk file open as _File_descriptor for reading, if it's at least _Minimum_size bytes
+_NODISCARD _Success_(return == __std_win_error::_Success) __std_win_error __stdcall __std_fs_map_file_for_reading(
+    _In_ int _File_descriptor, _In_ unsigned long long _Minimum_size, _Out_ const void** _View,
+    _Out_ size_t* _View_size) noexcept;
+
+void __stdcall __std_fs_unmap_file(_In_ const void* _View) noexcept;
 } // extern "C"
 
 _STD_BEGIN
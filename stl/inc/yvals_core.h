@@ -410,6 +410,11 @@
 //     (partial implementation; see GH-4924)
 // P3567R2 flat_meow Fixes
 
+// _HAS_CXX26 controls:
+// P0843R14 inplace_vector
+// P2530R3 Hazard Pointers
+// P2545R4 Read-Copy Update (RCU)
+
 // Parallel Algorithms Notes
 // C++ allows an implementation to implement parallel algorithms as calls to the serial algorithms.
 // This implementation parallelizes several common algorithm calls, but not all.
@@ -1047,6 +1052,74 @@ _EMIT_STL_ERROR(STL1004, "C++98 unexpected() is incompatible with C++23 unexpect
 #endif // ^^^ floating-point exceptions disabled (default) ^^^
 #endif // !defined(_STD_VECTORIZE_WITH_FLOAT_CONTROL)
 
+// Controls how many pause instructions atomic waits and counting_semaphore may execute while polling before they block;
+// 0 disables polling. The separately compiled library lowers this limit for addresses whose waits tend to be long.
+#ifndef _STD_ATOMIC_WAIT_SPIN_LIMIT
+#define _STD_ATOMIC_WAIT_SPIN_LIMIT 256
+#endif // !defined(_STD_ATOMIC_WAIT_SPIN_LIMIT)
+
+// Controls whether atomic<shared_ptr<T>> on 64-bit targets loads without locking: each stored value carries a batch of
+// references that load() claims with one 16-byte compare-exchange. A load that finds the batch exhausted waits for a
+// reader that is replenishing it, so load() is still not lock-free and is_lock_free() remains false. While a value is
+// stored, use_count() includes its unclaimed references. Code built without it would mistake part of that batch for
+// its lock bit, so <memory> records this setting with #pragma detect_mismatch to turn mixing the two into a link error.
+#ifndef _STD_ATOMIC_SHARED_PTR_LOCK_FREE_LOAD
+#define _STD_ATOMIC_SHARED_PTR_LOCK_FREE_LOAD 0
+#endif // !defined(_STD_ATOMIC_SHARED_PTR_LOCK_FREE_LOAD)
+
+// Controls whether stop_callback registers with a single compare-exchange on the stop state's callback list, and
+// deregisters with one when it is the most recently registered callback, instead of locking the list each time.
+// The list is then singly linked through tagged pointers, which a stop_source or stop_callback built without it would
+// follow as plain pointers, so <stop_token> records this setting with #pragma detect_mismatch.
+#ifndef _STD_STOP_CALLBACK_LOCK_FREE
+#define _STD_STOP_CALLBACK_LOCK_FREE 0
+#endif // !defined(_STD_STOP_CALLBACK_LOCK_FREE)
+
+// Controls whether basic_filebuf<char> opened in binary mode reads large blocks straight into the caller's buffer, and
+// whether one opened in binary mode for input only memory-maps the file and uses the mapping as its get area. The
+// mapping is stored in basic_filebuf, and code built without this setting would both misjudge the object's size and
+// treat the mapped get area as the C stream's buffer, so the internal header that defines basic_filebuf records this
+// setting with #pragma detect_mismatch. The static library's standard streams are built without it, so with /MT or
+// /MTd, a program that enables it and uses cin, cout, cerr, clog, or their wide counterparts fails to link.
+#ifndef _STD_FILEBUF_LARGE_BLOCK_IO
+#define _STD_FILEBUF_LARGE_BLOCK_IO 0
+#endif // !defined(_STD_FILEBUF_LARGE_BLOCK_IO)
+
+// Controls whether each chrono::time_zone remembers the sys_info intervals it has looked up, so that get_info, to_sys,
+// and to_local answer repeated queries from nearby times without calling into the time zone database. The cache is a
+// member of time_zone, and tzdb::zones is filled once per program by whichever translation unit first loads the
+// database, so code built with another setting would step through that vector with the wrong element size; <chrono>
+// records this setting with #pragma detect_mismatch.
+#ifndef _STD_TIME_ZONE_INFO_CACHE
+#define _STD_TIME_ZONE_INFO_CACHE 0
+#endif // !defined(_STD_TIME_ZONE_INFO_CACHE)
+
+// Controls whether each chrono::tzdb carries a hash table from zone and link names to time_zones, which locate_zone
+// and current_zone search instead of the sorted zones and links vectors. The table is a member of tzdb, and the
+// program's single tzdb_list may be loaded or reloaded by code built with either setting, so code built without it
+// would misjudge the size of each tzdb and code built with it would read a table that was never there; <chrono>
+// records this setting with #pragma detect_mismatch.
+#ifndef _STD_TZDB_NAME_INDEX
+#define _STD_TZDB_NAME_INDEX 0
+#endif // !defined(_STD_TZDB_NAME_INDEX)
+
+// Controls whether std::async(launch::async, ...) runs tasks on the STL's own thread pool instead of the Concurrency
+// Runtime. That pool has a fixed number of threads (see stdext::set_thread_pool_size), and once it has started, the
+// parallel algorithms run on it too. A task that hasn't started when its future is waited on runs on the waiting
+// thread, but tasks that block on each other in other ways can deadlock when every pool thread is blocked.
+#ifndef _STD_ASYNC_THREAD_POOL
+#define _STD_ASYNC_THREAD_POOL 0
+#endif // !defined(_STD_ASYNC_THREAD_POOL)
+
+// Controls whether stdext::then, when_all, and when_any register their continuations with each input's shared state,
+// so that the thread making the input ready queues them on the thread pool, instead of starting a thread that waits
+// for each input that isn't ready yet. Shared states created by code built without it never queue registered
+// continuations, which then never run. <future> records this setting with #pragma detect_mismatch, which catches
+// statically linked code; futures returned by DLLs must also come from code built with it.
+#ifndef _STD_FUTURE_CONTINUATIONS
+#define _STD_FUTURE_CONTINUATIONS 0
+#endif // !defined(_STD_FUTURE_CONTINUATIONS)
+
 // P0174R2 Deprecating Vestigial Library Parts
 // P0521R0 Deprecating shared_ptr::unique()
 // Other C++17 deprecation warnings
@@ -1799,6 +1872,13 @@ _EMIT_STL_ERROR(STL1004, "C++98 unexpected() is incompatible with C++23 unexpect
 #define __cpp_lib_unreachable                 202202L
 #endif // _HAS_CXX23
 
+// C++26
+#if _HAS_CXX26
+#define __cpp_lib_hazard_pointer 202306L
+#define __cpp_lib_inplace_vector 202406L
+#define __cpp_lib_rcu            202306L
+#endif // _HAS_CXX26
+
 // macros with language mode sensitivity
 #if _HAS_CXX20
 #define __cpp_lib_array_constexpr 201811L // P1032R1 Miscellaneous constexpr
@@ -1901,6 +1981,16 @@ _EMIT_STL_ERROR(STL1013, "The STL doesn't support /RTCc because it rejects confo
 #define _CHRONO ::std::chrono::
 #define _RANGES ::std::ranges::
 
+// non-Standard extensions live in namespace stdext
+#define _STDEXT_BEGIN      \
+    _EXTERN_CXX_WORKAROUND \
+    namespace stdext {
+#define _STDEXT_END \
+    }               \
+    _END_EXTERN_CXX_WORKAROUND
+
+#define _STDEXT ::stdext::
+
 #define _CSTD ::
 
 #ifdef _M_CEE_PURE
@@ -133,6 +133,12 @@ export module std;
 #include <stdfloat>
 #endif // _HAS_CXX23
 
+#if _HAS_CXX26
+#include <hazard_pointer>
+#include <inplace_vector>
+#include <rcu>
+#endif // _HAS_CXX26
+
 // "C++ headers for C library facilities" [tab:headers.cpp.c]
 #include <cassert>
 #include <cctype>
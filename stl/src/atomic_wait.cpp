@@ -4,6 +4,7 @@
 // implement atomic wait / notify_one / notify_all
 
 #include <atomic>
+#include <climits>
 #include <cstdint>
 #include <cstdlib>
 #include <new>
@@ -20,61 +21,148 @@ namespace {
     constexpr size_t _Wait_table_size       = 1 << _Wait_table_size_power;
     constexpr size_t _Wait_table_index_mask = _Wait_table_size - 1;
 
-    struct _Wait_context {
-        const void* _Storage; // Pointer to wait on
-        _Wait_context* _Next;
-        _Wait_context* _Prev;
-        CONDITION_VARIABLE _Condition;
+    // _Waiter_count of a free _Wait_node while one waiter gives it a new address
+    constexpr unsigned long _Claiming = ULONG_MAX;
+
+    struct _Wait_queue {
+        // Indirect waiters sleep on _Sequence with WaitOnAddress; notifiers advance it and wake them all.
+        // _Waiter_count lets notifiers skip the wake entirely when nobody is waiting in this queue.
+        _STD atomic<unsigned long> _Sequence{0};
+        _STD atomic<unsigned long> _Waiter_count{0};
+    };
+
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    struct alignas(_STD hardware_destructive_interference_size) _Wait_node : _Wait_queue {
+        // The queue of indirect waiters on the single address _Address. Nodes are never freed, so the lists
+        // in the wait table can be walked without locks; once its waiters have left, a node keeps its address
+        // until a waiter on another address claims it.
+        _STD atomic<const void*> _Address{nullptr};
+        _Wait_node* _Next = nullptr; // immutable once the node is published
     };
 
-    struct [[nodiscard]] _Guarded_wait_context : _Wait_context {
-        _Guarded_wait_context(const void* _Storage_, _Wait_context* const _Head) noexcept
-            : _Wait_context{_Storage_, _Head, _Head->_Prev, CONDITION_VARIABLE_INIT} {
-            _Prev->_Next = this;
-            _Next->_Prev = this;
+    struct alignas(_STD hardware_destructive_interference_size) _Wait_table_entry {
+        // _Nodes lists the per-address queues of the addresses hashing to this entry, newest first.
+        // If a node can't be allocated, waiters fall back to _Shared, which every notification to this entry wakes.
+        // Since _Wait_table_entry is initialized to all zero bytes,
+        // _Atomic_wait_table_entry::wait_table will also be all zero bytes.
+        // It can thus can be stored in the .bss section, and not in the actual binary.
+        _STD atomic<_Wait_node*> _Nodes{nullptr};
+        _Wait_queue _Shared;
+        // Halvings applied to the caller's spin limit; adjusted by how long recent direct waits blocked.
+        _STD atomic<unsigned char> _Spin_shift{0};
+
+        constexpr _Wait_table_entry() noexcept = default;
+    };
+#pragma warning(pop)
+
+    struct _Wait_statistics {
+        _STD atomic<unsigned long long> _Waits{0};
+        _STD atomic<unsigned long long> _Collisions{0};
+        _STD atomic<unsigned long long> _Spurious_wakeups{0};
+        _STD atomic<size_t> _Queues{0};
+    };
+
+    _Wait_statistics _Statistics;
+
+    [[nodiscard]] bool _Try_join(_Wait_node& _Node, const void* const _Storage) noexcept {
+        auto _Count = _Node._Waiter_count.load(_STD memory_order_relaxed);
+        do {
+            if (_Count == _Claiming) {
+                return false;
+            }
+        } while (!_Node._Waiter_count.compare_exchange_weak(
+            _Count, _Count + 1, _STD memory_order_acquire, _STD memory_order_relaxed));
+
+        // while it has a waiter, the node can't be claimed for another address
+        if (_Node._Address.load(_STD memory_order_relaxed) == _Storage) {
+            return true;
         }
 
-        ~_Guarded_wait_context() {
-            const auto _Next_local = _Next;
-            const auto _Prev_local = _Prev;
-            _Next->_Prev           = _Prev_local;
-            _Prev->_Next           = _Next_local;
+        _Node._Waiter_count.fetch_sub(1, _STD memory_order_relaxed);
+        return false;
+    }
+
+    [[nodiscard]] bool _Try_claim(_Wait_node& _Node, const void* const _Storage) noexcept {
+        unsigned long _Free = 0;
+        if (!_Node._Waiter_count.compare_exchange_strong(
+                _Free, _Claiming, _STD memory_order_acquire, _STD memory_order_relaxed)) {
+            return false;
         }
 
-        _Guarded_wait_context(const _Guarded_wait_context&)            = delete;
-        _Guarded_wait_context& operator=(const _Guarded_wait_context&) = delete;
-    };
+        _Node._Address.store(_Storage, _STD memory_order_relaxed);
+        _Node._Waiter_count.store(1, _STD memory_order_release);
+        return true;
+    }
 
-    class [[nodiscard]] _SrwLock_guard {
-    public:
-        explicit _SrwLock_guard(SRWLOCK& _Locked_) noexcept : _Locked(&_Locked_) {
-            AcquireSRWLockExclusive(_Locked);
+    [[nodiscard]] _Wait_queue& _Join_wait_queue(_Wait_table_entry& _Entry, const void* const _Storage) noexcept {
+        // Joins a queue for _Storage: an existing node for it, else a free node, else a newly allocated node.
+        _Wait_queue* _Queue     = nullptr;
+        _Wait_node* _Free       = nullptr;
+        bool _Collided          = false;
+        _Wait_node* const _Head = _Entry._Nodes.load(_STD memory_order_acquire);
+        for (auto _Node = _Head; _Node; _Node = _Node->_Next) {
+            if (_Node->_Address.load(_STD memory_order_relaxed) == _Storage) {
+                if (_Try_join(*_Node, _Storage)) {
+                    _Queue = _Node;
+                    break;
+                }
+            } else if (_Node->_Waiter_count.load(_STD memory_order_relaxed) != 0) {
+                _Collided = true;
+            } else if (!_Free) {
+                _Free = _Node;
+            }
         }
 
-        ~_SrwLock_guard() {
-            ReleaseSRWLockExclusive(_Locked);
+        if (!_Queue && _Free && _Try_claim(*_Free, _Storage)) {
+            _Queue = _Free;
         }
 
-        _SrwLock_guard(const _SrwLock_guard&)            = delete;
-        _SrwLock_guard& operator=(const _SrwLock_guard&) = delete;
+        if (!_Queue) {
+            const auto _New = new (_STD nothrow) _Wait_node;
+            if (_New) {
+                _New->_Address.store(_Storage, _STD memory_order_relaxed);
+                _New->_Waiter_count.store(1, _STD memory_order_relaxed);
+                _Wait_node* _Next = _Head;
+                do {
+                    _New->_Next = _Next;
+                } while (!_Entry._Nodes.compare_exchange_weak(
+                    _Next, _New, _STD memory_order_release, _STD memory_order_relaxed));
+
+                _Statistics._Queues.fetch_add(1, _STD memory_order_relaxed);
+                _Queue = _New;
+            } else {
+                _Entry._Shared._Waiter_count.fetch_add(1, _STD memory_order_relaxed);
+                _Queue    = &_Entry._Shared;
+                _Collided = true;
+            }
+        }
 
-    private:
-        SRWLOCK* _Locked;
-    };
+        _Statistics._Waits.fetch_add(1, _STD memory_order_relaxed);
+        if (_Collided) {
+            _Statistics._Collisions.fetch_add(1, _STD memory_order_relaxed);
+        }
 
-#pragma warning(push)
-#pragma warning(disable : 4324) // structure was padded due to alignment specifier
-    struct alignas(_STD hardware_destructive_interference_size) _Wait_table_entry {
-        SRWLOCK _Lock = SRWLOCK_INIT;
-        // Initialize to all zeros, self-link lazily to optimize for space.
-        // Since _Wait_table_entry is initialized to all zero bytes,
-        // _Atomic_wait_table_entry::wait_table will also be all zero bytes.
-        // It can thus can be stored in the .bss section, and not in the actual binary.
-        _Wait_context _Wait_list_head = {nullptr, nullptr, nullptr, CONDITION_VARIABLE_INIT};
+        // pairs with the fence in _Notify_indirect: either the notifier sees this waiter,
+        // or this waiter sees the value stored before the notification
+        _STD atomic_thread_fence(_STD memory_order_seq_cst);
+        return *_Queue;
+    }
 
-        constexpr _Wait_table_entry() noexcept = default;
+    class [[nodiscard]] _Wait_queue_guard {
+    public:
+        _Wait_queue_guard(_Wait_table_entry& _Entry, const void* const _Storage) noexcept
+            : _Queue(&_Join_wait_queue(_Entry, _Storage)) {}
+
+        ~_Wait_queue_guard() {
+            _Queue->_Waiter_count.fetch_sub(1, _STD memory_order_relaxed);
+        }
+
+        _Wait_queue_guard(const _Wait_queue_guard&)            = delete;
+        _Wait_queue_guard& operator=(const _Wait_queue_guard&) = delete;
+
+        _Wait_queue* const _Queue;
     };
-#pragma warning(pop)
 
     [[nodiscard]] _Wait_table_entry& _Atomic_wait_table_entry(const void* const _Storage) noexcept {
         static _Wait_table_entry wait_table[_Wait_table_size];
@@ -91,20 +179,93 @@ namespace {
         }
 #endif // defined(_DEBUG)
     }
+
+    constexpr unsigned char _Max_spin_shift = 16;
+
+    // Waits that block for less than this would likely have been avoided by spinning somewhat longer.
+    constexpr long long _Short_wait_microseconds = 20;
+
+    [[nodiscard]] long long _Short_wait_ticks() noexcept {
+        static const long long _Ticks = [] {
+            LARGE_INTEGER _Frequency;
+            QueryPerformanceFrequency(&_Frequency);
+            return _Frequency.QuadPart * _Short_wait_microseconds / 1'000'000;
+        }();
+        return _Ticks;
+    }
+
+    void _Record_wait_duration(const void* const _Storage, const long long _Ticks) noexcept {
+        // lengthen the spins before short waits, and shorten the spins before long ones
+        auto& _Shift             = _Atomic_wait_table_entry(_Storage)._Spin_shift;
+        const unsigned char _Old = _Shift.load(_STD memory_order_relaxed);
+        unsigned char _New       = _Old;
+        if (_Ticks < _Short_wait_ticks()) {
+            if (_New != 0) {
+                --_New;
+            }
+        } else if (_New != _Max_spin_shift) {
+            ++_New;
+        }
+
+        if (_New != _Old) { // a lost update only delays the adaptation
+            _Shift.store(_New, _STD memory_order_relaxed);
+        }
+    }
+
+    void _Wake_all(_Wait_queue& _Queue) noexcept {
+        _Queue._Sequence.fetch_add(1, _STD memory_order_release);
+        WakeByAddressAll(&_Queue._Sequence);
+    }
+
+    void _Notify_indirect(const void* const _Storage) noexcept {
+        // Wakes all waiters in the queues for _Storage (usually one, but racing waiters may have made more),
+        // who then recheck their values; this never takes a lock.
+        auto& _Entry = _Atomic_wait_table_entry(_Storage);
+        _STD atomic_thread_fence(_STD memory_order_seq_cst);
+        if (_Entry._Shared._Waiter_count.load(_STD memory_order_relaxed) != 0) {
+            _Wake_all(_Entry._Shared);
+        }
+
+        for (auto _Node = _Entry._Nodes.load(_STD memory_order_acquire); _Node; _Node = _Node->_Next) {
+            // acquire makes the address visible if the waiter count comes from a waiter that claimed the node
+            if (_Node->_Waiter_count.load(_STD memory_order_acquire) != 0
+                && _Node->_Address.load(_STD memory_order_relaxed) == _Storage) {
+                _Wake_all(*_Node);
+            }
+        }
+    }
 } // unnamed namespace
 
 extern "C" {
 int __stdcall __std_atomic_wait_direct(const void* const _Storage, void* const _Comparand, const size_t _Size,
     const unsigned long _Remaining_timeout) noexcept {
+    LARGE_INTEGER _Start;
+    QueryPerformanceCounter(&_Start);
     const auto _Result =
         WaitOnAddress(const_cast<volatile void*>(_Storage), const_cast<void*>(_Comparand), _Size, _Remaining_timeout);
 
-    if (!_Result) {
+    if (_Result) {
+        LARGE_INTEGER _Finish;
+        QueryPerformanceCounter(&_Finish);
+        _Record_wait_duration(_Storage, _Finish.QuadPart - _Start.QuadPart);
+    } else {
         _Assume_timeout();
+        _Record_wait_duration(_Storage, LLONG_MAX);
     }
+
     return _Result;
 }
 
+unsigned long __stdcall __std_atomic_wait_spin_limit(
+    const void* const _Storage, const unsigned long _Max_spins) noexcept {
+    const unsigned char _Shift = _Atomic_wait_table_entry(_Storage)._Spin_shift.load(_STD memory_order_relaxed);
+    if (_Shift == _Max_spin_shift) {
+        return 0;
+    }
+
+    return _Max_spins >> _Shift;
+}
+
 void __stdcall __std_atomic_notify_one_direct(const void* const _Storage) noexcept {
     WakeByAddressSingle(const_cast<void*>(_Storage));
 }
@@ -114,58 +275,29 @@ void __stdcall __std_atomic_notify_all_direct(const void* const _Storage) noexce
 }
 
 void __stdcall __std_atomic_notify_one_indirect(const void* const _Storage) noexcept {
-    auto& _Entry = _Atomic_wait_table_entry(_Storage);
-    _SrwLock_guard _Guard(_Entry._Lock);
-    _Wait_context* _Context = _Entry._Wait_list_head._Next;
-
-    if (_Context == nullptr) {
-        return;
-    }
-
-    for (; _Context != &_Entry._Wait_list_head; _Context = _Context->_Next) {
-        if (_Context->_Storage == _Storage) {
-            // Can't move wake outside SRWLOCKed section: SRWLOCK also protects the _Context itself
-            WakeAllConditionVariable(&_Context->_Condition);
-            break;
-        }
-    }
+    _Notify_indirect(_Storage);
 }
 
 void __stdcall __std_atomic_notify_all_indirect(const void* const _Storage) noexcept {
-    auto& _Entry = _Atomic_wait_table_entry(_Storage);
-    _SrwLock_guard _Guard(_Entry._Lock);
-    _Wait_context* _Context = _Entry._Wait_list_head._Next;
-
-    if (_Context == nullptr) {
-        return;
-    }
-
-    for (; _Context != &_Entry._Wait_list_head; _Context = _Context->_Next) {
-        if (_Context->_Storage == _Storage) {
-            // Can't move wake outside SRWLOCKed section: SRWLOCK also protects the _Context itself
-            WakeAllConditionVariable(&_Context->_Condition);
-        }
-    }
+    _Notify_indirect(_Storage);
 }
 
 int __stdcall __std_atomic_wait_indirect(const void* _Storage, void* _Comparand, size_t _Size, void* _Param,
     _Atomic_wait_indirect_equal_callback_t _Are_equal, unsigned long _Remaining_timeout) noexcept {
-    auto& _Entry = _Atomic_wait_table_entry(_Storage);
-
-    _SrwLock_guard _Guard(_Entry._Lock);
-
-    if (_Entry._Wait_list_head._Next == nullptr) {
-        _Entry._Wait_list_head._Next = &_Entry._Wait_list_head;
-        _Entry._Wait_list_head._Prev = &_Entry._Wait_list_head;
-    }
-
-    _Guarded_wait_context _Context{_Storage, &_Entry._Wait_list_head};
-    for (;;) {
-        if (!_Are_equal(_Storage, _Comparand, _Size, _Param)) { // note: under lock to prevent lost wakes
+    _Wait_queue_guard _Guard(_Atomic_wait_table_entry(_Storage), _Storage);
+    auto& _Queue = *_Guard._Queue;
+    for (bool _Woken = false;; _Woken = true) {
+        // load the sequence before comparing, so that a notification after the comparison changes it
+        auto _Sequence = _Queue._Sequence.load(_STD memory_order_acquire);
+        if (!_Are_equal(_Storage, _Comparand, _Size, _Param)) {
             return TRUE;
         }
 
-        if (!SleepConditionVariableSRW(&_Context._Condition, &_Entry._Lock, _Remaining_timeout, 0)) {
+        if (_Woken) {
+            _Statistics._Spurious_wakeups.fetch_add(1, _STD memory_order_relaxed);
+        }
+
+        if (!WaitOnAddress(&_Queue._Sequence, &_Sequence, sizeof(_Sequence), _Remaining_timeout)) {
             _Assume_timeout();
             return FALSE;
         }
@@ -177,6 +309,13 @@ int __stdcall __std_atomic_wait_indirect(const void* _Storage, void* _Comparand,
     }
 }
 
+void __stdcall __std_atomic_wait_get_statistics(__std_atomic_wait_statistics* const _Stats) noexcept {
+    _Stats->_Waits            = _Statistics._Waits.load(_STD memory_order_relaxed);
+    _Stats->_Collisions       = _Statistics._Collisions.load(_STD memory_order_relaxed);
+    _Stats->_Spurious_wakeups = _Statistics._Spurious_wakeups.load(_STD memory_order_relaxed);
+    _Stats->_Queues           = _Statistics._Queues.load(_STD memory_order_relaxed);
+}
+
 // TRANSITION, ABI: preserved for binary compatibility
 unsigned long long __stdcall __std_atomic_wait_get_deadline(const unsigned long long _Timeout) noexcept {
     if (_Timeout == _Atomic_wait_no_deadline) {
@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <internal_shared.h>
+#include <io.h>
 #include <xfilesystem_abi.h>
 
 #include <Windows.h>
@@ -217,8 +218,10 @@ static_assert(alignof(WIN32_FIND_DATAW) == alignof(__std_fs_find_data));
 [[nodiscard]] __std_win_error __stdcall __std_fs_directory_iterator_open(_In_z_ const wchar_t* const _Path_spec,
     _Inout_ __std_fs_dir_handle* const _Handle, _Out_ __std_fs_find_data* const _Results) noexcept {
     __std_fs_directory_iterator_close(*_Handle);
-    *_Handle = __std_fs_dir_handle{reinterpret_cast<intptr_t>(
-        FindFirstFileExW(_Path_spec, FindExInfoBasic, _Results, FindExSearchNameMatch, nullptr, 0))};
+    // FIND_FIRST_EX_LARGE_FETCH lets each call into the file system return more entries, so that
+    // __std_fs_directory_iterator_advance usually copies out a buffered entry instead of making a call
+    *_Handle = __std_fs_dir_handle{reinterpret_cast<intptr_t>(FindFirstFileExW(
+        _Path_spec, FindExInfoBasic, _Results, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH))};
     if (*_Handle != __std_fs_dir_handle::_Invalid) {
         return __std_win_error::_Success;
     }
@@ -1036,4 +1039,50 @@ namespace {
     return __std_win_error{GetLastError()};
 }
 
+[[nodiscard]] _Success_(return == __std_win_error::_Success) __std_win_error __stdcall __std_fs_map_file_for_reading(
+    _In_ const int _File_descriptor, _In_ const unsigned long long _Minimum_size, _Out_ const void** const _View,
+    _Out_ size_t* const _View_size) noexcept {
+    *_View      = nullptr;
+    *_View_size = 0;
+
+    const auto _Handle = reinterpret_cast<HANDLE>(_get_osfhandle(_File_descriptor));
+    if (_Handle == INVALID_HANDLE_VALUE) {
+        return __std_win_error::_Invalid_parameter;
+    }
+
+    if (GetFileType(_Handle) != FILE_TYPE_DISK) { // pipes and consoles can't be mapped
+        return __std_win_error::_Not_supported;
+    }
+
+    LARGE_INTEGER _File_size;
+    if (!GetFileSizeEx(_Handle, &_File_size)) {
+        return __std_win_error{GetLastError()};
+    }
+
+    const auto _Size = static_cast<unsigned long long>(_File_size.QuadPart);
+    if (_Size == 0 || _Size < _Minimum_size || _Size > SIZE_MAX) { // empty files can't be mapped
+        return __std_win_error::_Not_supported;
+    }
+
+    const HANDLE _Mapping = CreateFileMappingW(_Handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_Mapping) {
+        return __std_win_error{GetLastError()};
+    }
+
+    // the view keeps the mapping alive, and also keeps the file from being truncated while it is mapped
+    const void* const _Base = MapViewOfFile(_Mapping, FILE_MAP_READ, 0, 0, 0);
+    const __std_win_error _Last_error{_Base ? ERROR_SUCCESS : GetLastError()};
+    CloseHandle(_Mapping);
+    if (_Base) {
+        *_View      = _Base;
+        *_View_size = static_cast<size_t>(_Size);
+    }
+
+    return _Last_error;
+}
+
+void __stdcall __std_fs_unmap_file(_In_ const void* const _View) noexcept {
+    UnmapViewOfFile(_View);
+}
+
 } // extern "C"
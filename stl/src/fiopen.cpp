@@ -3,6 +3,8 @@
 
 // _Fiopen(const char */const wchar_t *, ios_base::openmode)
 
+#define _STL_FILEBUF_LAYOUT_UNUSED // see __msvc_filebuf.hpp; only basic_filebuf::open calls _Fiopen
+
 #include <fstream>
 
 namespace {
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// implement the table of continuations registered on future shared states
+
+#include <__msvc_thread_pool.hpp>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#pragma warning(disable : 4074)
+#pragma init_seg(compiler)
+
+namespace {
+    struct _Continuation_list {
+        __std_future_continuation* _Head = nullptr;
+        __std_future_continuation* _Tail = nullptr;
+    };
+
+    using _Map_alloc = _STD _Crt_allocator<_STD pair<const void* const, _Continuation_list>>;
+    using _Map_type  = _STD map<const void*, _Continuation_list, _STD less<const void*>, _Map_alloc>;
+
+    _Map_type _Lookup_map;
+    _STD mutex _Lookup_mutex;
+} // unnamed namespace
+
+extern "C" {
+
+[[nodiscard]] bool __stdcall __std_future_add_continuation(
+    const void* const _State, __std_future_continuation* const _Continuation) noexcept {
+    _Continuation->_Next = nullptr;
+    try {
+        _STD scoped_lock _Guard(_Lookup_mutex);
+        auto& _List = _Lookup_map.try_emplace(_State).first->second;
+        if (_List._Tail) {
+            _List._Tail->_Next = _Continuation;
+        } else {
+            _List._Head = _Continuation;
+        }
+
+        _List._Tail = _Continuation;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+[[nodiscard]] __std_future_continuation* __stdcall __std_future_take_continuations(const void* const _State) noexcept {
+    _STD scoped_lock _Guard(_Lookup_mutex);
+    const auto _Iter = _Lookup_map.find(_State);
+    if (_Iter == _Lookup_map.end()) {
+        return nullptr;
+    }
+
+    const auto _Head = _Iter->second._Head;
+    _Lookup_map.erase(_Iter);
+    return _Head;
+}
+
+} // extern "C"
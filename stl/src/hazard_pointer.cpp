@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// implement hazard pointers
+
+#include <__msvc_safe_reclamation.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include <Windows.h>
+
+namespace {
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    struct alignas(_STD hardware_destructive_interference_size) _Hazard_record {
+        _STD atomic<const void*> _Protected{nullptr}; // must be first, see __std_hazard_pointer_release
+        _STD atomic<bool> _Acquired{false};
+        _Hazard_record* _Next = nullptr;
+    };
+
+    struct alignas(_STD hardware_destructive_interference_size) _Retire_record {
+        _STD atomic<__std_reclaimable*> _Retired{nullptr}; // pushed by the owner, taken by the owner's scans or by
+                                                           // any scan once the owner has exited
+        size_t _Retired_count = 0; // only accessed by the owner
+        HANDLE _Owner         = nullptr; // guarded by _Retire_records_mutex; null if the owner can't be tracked
+        _Retire_record* _Next = nullptr;
+    };
+#pragma warning(pop)
+
+    // Records are never freed, so scans can walk the list without synchronizing with acquisition and release.
+    _STD atomic<_Hazard_record*> _Hazard_records{nullptr};
+    _STD atomic<size_t> _Hazard_record_count{0};
+
+    // Each thread batches its retired objects in its own record. Handing the batch over when the thread exits would
+    // need a thread_local destructor, which runs under the loader lock, so as in rcu.cpp, a record instead remembers
+    // its owner and is reused once the owner has exited. Until then, the next scan of any thread adopts its objects.
+    _Retire_record* _Retire_records = nullptr; // guarded by _Retire_records_mutex
+    _STD mutex _Retire_records_mutex;
+
+    // A thread scans once it has retired this many objects or twice the number of hazard pointers, whichever is
+    // larger, so that each scan reclaims at least half of them.
+    constexpr size_t _Min_retired_batch = 64;
+
+    [[nodiscard]] bool _Owner_exited(const _Retire_record& _Record) noexcept { // pre: _Retire_records_mutex is held
+        // waiting for an exited thread synchronizes with everything it did, including its last retirements
+        return _Record._Owner && WaitForSingleObject(_Record._Owner, 0) == WAIT_OBJECT_0;
+    }
+
+    [[nodiscard]] _Retire_record* _Acquire_record() noexcept {
+        HANDLE _Self;
+        if (!DuplicateHandle(
+                GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &_Self, SYNCHRONIZE, FALSE, 0)) {
+            _Self = nullptr; // the record won't be reused after this thread exits
+        }
+
+        _STD lock_guard _Guard{_Retire_records_mutex};
+        for (auto _Record = _Retire_records; _Record; _Record = _Record->_Next) {
+            if (_Owner_exited(*_Record)) {
+                CloseHandle(_Record->_Owner);
+                _Record->_Owner         = _Self;
+                _Record->_Retired_count = 0; // the objects that the previous owner left are counted by nobody
+                return _Record;
+            }
+        }
+
+        // retire() cannot fail, so running out of memory here terminates
+        const auto _New_record = new _Retire_record;
+        _New_record->_Owner    = _Self;
+        _New_record->_Next     = _Retire_records;
+        _Retire_records        = _New_record;
+        return _New_record;
+    }
+
+    thread_local _Retire_record* _Thread_record = nullptr;
+
+    [[nodiscard]] _Retire_record& _Get_record() noexcept {
+        if (!_Thread_record) {
+            _Thread_record = _Acquire_record();
+        }
+
+        return *_Thread_record;
+    }
+
+    void _Push_retired(
+        _Retire_record& _Record, __std_reclaimable* const _First, __std_reclaimable* const _Last) noexcept {
+        auto _Head = _Record._Retired.load(_STD memory_order_relaxed);
+        do {
+            _Last->_Next = _Head;
+        } while (!_Record._Retired.compare_exchange_weak(
+            _Head, _First, _STD memory_order_release, _STD memory_order_relaxed));
+    }
+
+    void _Append_list(__std_reclaimable*& _List, __std_reclaimable* const _Other) noexcept {
+        if (!_Other) {
+            return;
+        }
+
+        auto _Last = _Other;
+        while (_Last->_Next) {
+            _Last = _Last->_Next;
+        }
+
+        _Last->_Next = _List;
+        _List        = _Other;
+    }
+
+    void _Adopt_orphaned_objects(__std_reclaimable*& _Retired) noexcept {
+        _STD lock_guard _Guard{_Retire_records_mutex};
+        for (auto _Record = _Retire_records; _Record; _Record = _Record->_Next) {
+            if (_Owner_exited(*_Record)) {
+                _Append_list(_Retired, _Record->_Retired.exchange(nullptr, _STD memory_order_acq_rel));
+            }
+        }
+    }
+
+    [[nodiscard]] bool _Is_protected(const void* const _Object) noexcept {
+        for (auto _Record = _Hazard_records.load(_STD memory_order_acquire); _Record; _Record = _Record->_Next) {
+            if (_Record->_Protected.load(_STD memory_order_relaxed) == _Object) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void _Reclaim_unprotected(_Retire_record& _Record) noexcept {
+        auto _Node = _Record._Retired.exchange(nullptr, _STD memory_order_acquire);
+        _Adopt_orphaned_objects(_Node);
+
+        // Pairs with the seq_cst store and load in hazard_pointer::try_protect: either the protecting thread
+        // observes that the object was unlinked, or this scan observes its protection.
+        _STD atomic_thread_fence(_STD memory_order_seq_cst);
+
+        __std_reclaimable* _Protected_first = nullptr;
+        __std_reclaimable* _Protected_last  = nullptr;
+        __std_reclaimable* _Unprotected     = nullptr;
+        size_t _Protected_count             = 0;
+        while (_Node) {
+            const auto _Next = _Node->_Next;
+            if (_Is_protected(_Node->_Object)) {
+                _Node->_Next     = _Protected_first;
+                _Protected_first = _Node;
+                if (!_Protected_last) {
+                    _Protected_last = _Node;
+                }
+
+                ++_Protected_count;
+            } else {
+                _Node->_Next = _Unprotected;
+                _Unprotected = _Node;
+            }
+
+            _Node = _Next;
+        }
+
+        // The objects that are still protected wait for the next scan.
+        if (_Protected_first) {
+            _Push_retired(_Record, _Protected_first, _Protected_last);
+        }
+
+        _Record._Retired_count = _Protected_count;
+
+        // Deleters may retire more objects, so they run only after the record is consistent again.
+        while (_Unprotected) {
+            const auto _Next = _Unprotected->_Next;
+            _Unprotected->_Reclaim(_Unprotected);
+            _Unprotected = _Next;
+        }
+    }
+} // unnamed namespace
+
+extern "C" {
+
+[[nodiscard]] void* __stdcall __std_hazard_pointer_acquire() noexcept {
+    for (auto _Record = _Hazard_records.load(_STD memory_order_acquire); _Record; _Record = _Record->_Next) {
+        if (!_Record->_Acquired.load(_STD memory_order_relaxed)
+            && !_Record->_Acquired.exchange(true, _STD memory_order_acquire)) {
+            return &_Record->_Protected;
+        }
+    }
+
+    const auto _New_record = new (_STD nothrow) _Hazard_record;
+    if (!_New_record) {
+        return nullptr;
+    }
+
+    _New_record->_Acquired.store(true, _STD memory_order_relaxed);
+    auto _Head = _Hazard_records.load(_STD memory_order_relaxed);
+    do {
+        _New_record->_Next = _Head;
+    } while (!_Hazard_records.compare_exchange_weak(
+        _Head, _New_record, _STD memory_order_release, _STD memory_order_relaxed));
+
+    _Hazard_record_count.fetch_add(1, _STD memory_order_relaxed);
+    return &_New_record->_Protected;
+}
+
+void __stdcall __std_hazard_pointer_release(void* const _Slot) noexcept {
+    static_assert(offsetof(_Hazard_record, _Protected) == 0);
+    const auto _Record = static_cast<_Hazard_record*>(_Slot);
+    _Record->_Protected.store(nullptr, _STD memory_order_release);
+    _Record->_Acquired.store(false, _STD memory_order_release);
+}
+
+void __stdcall __std_hazard_pointer_retire(__std_reclaimable* const _Retired) noexcept {
+    auto& _Record = _Get_record();
+    _Push_retired(_Record, _Retired, _Retired);
+    if (++_Record._Retired_count
+        >= (_STD max)(_Min_retired_batch, 2 * _Hazard_record_count.load(_STD memory_order_relaxed))) {
+        _Reclaim_unprotected(_Record);
+    }
+}
+
+} // extern "C"
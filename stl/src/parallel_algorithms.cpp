@@ -3,10 +3,33 @@
 
 // support for <execution>
 
+#include <cstdint>
 #include <internal_shared.h>
 #include <thread>
 #include <xatomic_wait.h>
 
+#include "thread_pool.hpp"
+
+namespace {
+    // Once the STL thread pool has started, parallel algorithms run on it rather than on the Windows thread pool,
+    // so that std::async and the parallel algorithms share one set of threads.
+    // The low bit of a PTP_WORK distinguishes the STL thread pool's work objects.
+    constexpr uintptr_t _Thread_pool_work_tag = 1;
+
+    [[nodiscard]] PTP_WORK _Tag_work(_Thread_pool_work* const _Work) noexcept {
+        return reinterpret_cast<PTP_WORK>(reinterpret_cast<uintptr_t>(_Work) | _Thread_pool_work_tag);
+    }
+
+    [[nodiscard]] _Thread_pool_work* _Untag_work(const PTP_WORK _Work) noexcept {
+        const auto _Bits = reinterpret_cast<uintptr_t>(_Work);
+        if ((_Bits & _Thread_pool_work_tag) == 0) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<_Thread_pool_work*>(_Bits & ~_Thread_pool_work_tag);
+    }
+} // unnamed namespace
+
 extern "C" {
 
 [[nodiscard]] unsigned int __stdcall __std_parallel_algorithms_hw_threads() noexcept {
@@ -22,25 +45,48 @@ extern "C" {
 
 [[nodiscard]] PTP_WORK __stdcall __std_create_threadpool_work(
     PTP_WORK_CALLBACK _Callback, void* _Context, PTP_CALLBACK_ENVIRON _Callback_environ) noexcept {
+    if (!_Callback_environ) {
+        if (const auto _Pool_work = _Create_thread_pool_work(_Callback, _Context)) {
+            return _Tag_work(_Pool_work);
+        }
+    }
+
     return CreateThreadpoolWork(_Callback, _Context, _Callback_environ);
 }
 
 void __stdcall __std_submit_threadpool_work(PTP_WORK _Work) noexcept {
-    SubmitThreadpoolWork(_Work);
+    if (const auto _Pool_work = _Untag_work(_Work)) {
+        _Submit_thread_pool_work(_Pool_work, 1);
+    } else {
+        SubmitThreadpoolWork(_Work);
+    }
 }
 
 void __stdcall __std_bulk_submit_threadpool_work(PTP_WORK _Work, const size_t _Submissions) noexcept {
+    if (const auto _Pool_work = _Untag_work(_Work)) {
+        _Submit_thread_pool_work(_Pool_work, _Submissions);
+        return;
+    }
+
     for (size_t _Idx = 0; _Idx < _Submissions; ++_Idx) {
         SubmitThreadpoolWork(_Work);
     }
 }
 
 void __stdcall __std_close_threadpool_work(PTP_WORK _Work) noexcept {
-    CloseThreadpoolWork(_Work);
+    if (const auto _Pool_work = _Untag_work(_Work)) {
+        _Close_thread_pool_work(_Pool_work);
+    } else {
+        CloseThreadpoolWork(_Work);
+    }
 }
 
 void __stdcall __std_wait_for_threadpool_work_callbacks(PTP_WORK _Work, BOOL _Cancel) noexcept {
-    WaitForThreadpoolWorkCallbacks(_Work, _Cancel);
+    if (const auto _Pool_work = _Untag_work(_Work)) {
+        _Wait_for_thread_pool_work_callbacks(_Pool_work, _Cancel != FALSE);
+    } else {
+        WaitForThreadpoolWorkCallbacks(_Work, _Cancel);
+    }
 }
 
 void __stdcall __std_execution_wait_on_uchar(const volatile unsigned char* _Address, unsigned char _Compare) noexcept {
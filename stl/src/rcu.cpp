@@ -0,0 +1,343 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// implement read-copy update
+
+#include <__msvc_safe_reclamation.hpp>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+
+#include <Windows.h>
+
+// Readers only store to their own record; grace periods pay for ordering those stores with FlushProcessWriteBuffers,
+// the Windows counterpart of membarrier(), so read-side critical sections need no fence instructions.
+
+namespace {
+    // A reader's counter is zero outside read-side critical sections; inside, it holds the nesting depth and the
+    // phase of the grace period that was current when the outermost critical section began.
+    constexpr unsigned long _Nesting_mask = 0xFFFF;
+    constexpr unsigned long _Phase_bit    = 0x1'0000;
+
+    // A thread's retired objects are closed into a batch that waits for a grace period once this many accumulate,
+    // and every time that many more accumulate, the thread advances the current grace period by one step.
+    constexpr size_t _Retired_batch = 128;
+
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    struct alignas(_STD hardware_destructive_interference_size) _Reader_record {
+        _STD atomic<unsigned long> _Counter{0};
+        _STD atomic<__std_reclaimable*> _Retired{nullptr}; // pushed by the owner, taken by any full batch once the
+                                                           // owner has exited, by the owner, or by rcu_barrier
+        _STD atomic<__std_reclaimable*> _Waiting{nullptr}; // the closed batch, taken like _Retired
+        unsigned long long _Waiting_target = 0; // the grace period that _Waiting needs, only accessed by the owner
+        size_t _Retired_count              = 0; // approximate, only accessed by the owner
+        HANDLE _Owner                      = nullptr; // guarded by _Reader_records_mutex; null if not trackable
+        _Reader_record* _Next              = nullptr;
+    };
+#pragma warning(pop)
+
+    // Records are never freed, so grace periods can walk the list without synchronizing with threads exiting.
+    // Releasing a record when its thread exits would need a thread_local destructor, which runs under the loader lock,
+    // so a record instead remembers its owner and is reused once the owner has exited. Until then, it keeps the
+    // retired objects that the owner left behind, which the next full batch of any thread or rcu_barrier reclaims.
+    _STD atomic<_Reader_record*> _Reader_records{nullptr};
+    _STD mutex _Reader_records_mutex; // serializes adding records and reusing them
+
+    // The phase bit of the current grace period, with a nesting depth of one for new readers to copy.
+    _STD atomic<unsigned long> _Current_counter{1};
+
+    _STD mutex _Grace_period_mutex;
+    _STD atomic<bool> _Grace_period_waiting{false};
+
+    // Grace periods are numbered from one in the order that they start, and they complete in that order too.
+    _STD atomic<unsigned long long> _Grace_periods_started{0};
+    _STD atomic<unsigned long long> _Grace_periods_completed{0};
+
+    // rcu_retire never waits for readers, because its caller may hold a lock that a reader needs in order to leave
+    // its critical section. Instead, each full batch advances a polled grace period by one step: the first flips the
+    // phase, and once no reader delays the latest flip, the next one flips again or, after two flips, finishes.
+    int _Polled_stage                       = 0; // guarded by _Grace_period_mutex; the number of flips made
+    unsigned long long _Polled_grace_period = 0; // guarded by _Grace_period_mutex
+
+    // Held shared while rcu_retire moves batches between the lists of a record, and exclusively by rcu_barrier while
+    // it takes all of them, so that no batch is in flight while rcu_barrier looks for one.
+    _STD shared_mutex _Batch_moves_mutex;
+
+    // Batches taken from their records that are not yet reclaimed, so rcu_barrier can wait for them.
+    _STD atomic<long> _Reclaims_in_progress{0};
+
+    [[nodiscard]] bool _Owner_exited(const _Reader_record& _Record) noexcept { // pre: _Reader_records_mutex is held
+        // waiting for an exited thread synchronizes with everything it did, including its last retirements
+        return _Record._Owner && WaitForSingleObject(_Record._Owner, 0) == WAIT_OBJECT_0;
+    }
+
+    [[nodiscard]] _Reader_record* _Acquire_record() noexcept {
+        HANDLE _Self;
+        if (!DuplicateHandle(
+                GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &_Self, SYNCHRONIZE, FALSE, 0)) {
+            _Self = nullptr; // the record won't be reused after this thread exits
+        }
+
+        _STD lock_guard _Guard{_Reader_records_mutex};
+        for (auto _Record = _Reader_records.load(_STD memory_order_relaxed); _Record; _Record = _Record->_Next) {
+            if (_Owner_exited(*_Record)) {
+                CloseHandle(_Record->_Owner);
+                _Record->_Owner         = _Self;
+                _Record->_Retired_count = 0;
+                return _Record;
+            }
+        }
+
+        // read-side critical sections cannot fail, so running out of memory here terminates
+        const auto _New_record = new _Reader_record;
+        _New_record->_Owner    = _Self;
+        _New_record->_Next     = _Reader_records.load(_STD memory_order_relaxed);
+        _Reader_records.store(_New_record, _STD memory_order_release);
+        return _New_record;
+    }
+
+    thread_local _Reader_record* _Thread_record = nullptr;
+
+    [[nodiscard]] _Reader_record& _Get_record() noexcept {
+        if (!_Thread_record) {
+            _Thread_record = _Acquire_record();
+        }
+
+        return *_Thread_record;
+    }
+
+    void _Splice_batch(__std_reclaimable*& _Batches, __std_reclaimable* _Batch) noexcept {
+        while (_Batch) {
+            const auto _Next = _Batch->_Next;
+            _Batch->_Next    = _Batches;
+            _Batches         = _Batch;
+            _Batch           = _Next;
+        }
+    }
+
+    void _Take_orphaned_batches(__std_reclaimable*& _Batches) noexcept {
+        _STD lock_guard _Guard{_Reader_records_mutex};
+        for (auto _Record = _Reader_records.load(_STD memory_order_relaxed); _Record; _Record = _Record->_Next) {
+            if (_Owner_exited(*_Record)) {
+                _Splice_batch(_Batches, _Record->_Retired.exchange(nullptr, _STD memory_order_acq_rel));
+                _Splice_batch(_Batches, _Record->_Waiting.exchange(nullptr, _STD memory_order_acq_rel));
+            }
+        }
+    }
+
+    void _Full_barrier_all_threads() noexcept {
+        _STD atomic_thread_fence(_STD memory_order_seq_cst);
+        FlushProcessWriteBuffers();
+        _STD atomic_thread_fence(_STD memory_order_seq_cst);
+    }
+
+    [[nodiscard]] bool _Delays_grace_period(const unsigned long _Counter) noexcept {
+        // A reader delays the grace period if its outermost critical section began before the last phase flip.
+        return (_Counter & _Nesting_mask) != 0
+            && ((_Counter ^ _Current_counter.load(_STD memory_order_relaxed)) & _Phase_bit) != 0;
+    }
+
+    void _Wait_for_readers() noexcept {
+        for (auto _Record = _Reader_records.load(_STD memory_order_acquire); _Record; _Record = _Record->_Next) {
+            for (;;) {
+                auto _Counter = _Record->_Counter.load(_STD memory_order_relaxed);
+                if (!_Delays_grace_period(_Counter)) {
+                    break;
+                }
+
+                // After this barrier, either the reader sees _Grace_period_waiting when it leaves its critical
+                // section and wakes us, or we see that it has already left.
+                _Grace_period_waiting.store(true, _STD memory_order_relaxed);
+                _Full_barrier_all_threads();
+                _Counter = _Record->_Counter.load(_STD memory_order_relaxed);
+                if (!_Delays_grace_period(_Counter)) {
+                    break;
+                }
+
+                __std_atomic_wait_direct(
+                    &_Record->_Counter, &_Counter, sizeof(_Counter), __std_atomic_wait_no_timeout);
+            }
+        }
+
+        _Grace_period_waiting.store(false, _STD memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool _Readers_delay_grace_period() noexcept {
+        for (auto _Record = _Reader_records.load(_STD memory_order_acquire); _Record; _Record = _Record->_Next) {
+            if (_Delays_grace_period(_Record->_Counter.load(_STD memory_order_relaxed))) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void _Flip_phase() noexcept {
+        _Current_counter.fetch_xor(_Phase_bit, _STD memory_order_relaxed);
+        // After this barrier, every reader that copied the old phase has published it, so later scans see it.
+        _Full_barrier_all_threads();
+    }
+
+    void _Synchronize() noexcept {
+        _STD lock_guard _Guard{_Grace_period_mutex};
+        const auto _Grace_period = _Grace_periods_started.fetch_add(1, _STD memory_order_seq_cst) + 1;
+        // Order the caller's preceding stores, such as unlinking an object, before the readers' subsequent loads.
+        _Full_barrier_all_threads();
+
+        // A reader may have loaded _Current_counter just before a flip and store it just after our scan, so two
+        // flips are needed to be sure that every reader observed in the old phase has been waited for.
+        for (int _Flip = 0; _Flip != 2; ++_Flip) {
+            _Flip_phase();
+            _Wait_for_readers();
+        }
+
+        // Order the readers' critical sections before whatever the caller does next, such as running deleters.
+        _Full_barrier_all_threads();
+
+        // This grace period started after any polled one that is in progress, so it completes that one too.
+        _Grace_periods_completed.store(_Grace_period, _STD memory_order_release);
+        _Polled_stage = 0;
+    }
+
+    void _Poll_grace_period() noexcept {
+        _STD unique_lock _Guard{_Grace_period_mutex, _STD try_to_lock};
+        if (!_Guard.owns_lock()) {
+            return; // another thread is making progress
+        }
+
+        if (_Polled_stage == 0) {
+            _Polled_grace_period = _Grace_periods_started.fetch_add(1, _STD memory_order_seq_cst) + 1;
+            _Full_barrier_all_threads(); // see _Synchronize
+            _Flip_phase();
+            _Polled_stage = 1;
+            return;
+        }
+
+        if (_Readers_delay_grace_period()) {
+            return; // try again on a later retirement
+        }
+
+        if (_Polled_stage == 1) {
+            _Flip_phase();
+            _Polled_stage = 2;
+            return;
+        }
+
+        _Full_barrier_all_threads(); // see _Synchronize
+        _Grace_periods_completed.store(_Polled_grace_period, _STD memory_order_release);
+        _Polled_stage = 0;
+    }
+
+    void _Reclaim(__std_reclaimable* _Retired) noexcept {
+        while (_Retired) {
+            const auto _Next = _Retired->_Next;
+            _Retired->_Reclaim(_Retired);
+            _Retired = _Next;
+        }
+    }
+
+    void _Finish_reclaim() noexcept {
+        if (_Reclaims_in_progress.fetch_sub(1, _STD memory_order_release) == 1) {
+            __std_atomic_notify_all_direct(&_Reclaims_in_progress);
+        }
+    }
+} // unnamed namespace
+
+extern "C" {
+
+void __stdcall __std_rcu_read_lock() noexcept {
+    auto& _Counter       = _Get_record()._Counter;
+    const auto _Previous = _Counter.load(_STD memory_order_relaxed);
+    if ((_Previous & _Nesting_mask) == 0) {
+        _Counter.store(_Current_counter.load(_STD memory_order_relaxed), _STD memory_order_relaxed);
+    } else {
+        _Counter.store(_Previous + 1, _STD memory_order_relaxed);
+    }
+
+    _STD atomic_signal_fence(_STD memory_order_seq_cst);
+}
+
+void __stdcall __std_rcu_read_unlock() noexcept {
+    _STD atomic_signal_fence(_STD memory_order_seq_cst);
+    auto& _Counter    = _Get_record()._Counter;
+    const auto _Value = _Counter.load(_STD memory_order_relaxed) - 1;
+    _Counter.store(_Value, _STD memory_order_relaxed);
+    _STD atomic_signal_fence(_STD memory_order_seq_cst); // see _Wait_for_readers
+    if ((_Value & _Nesting_mask) == 0 && _Grace_period_waiting.load(_STD memory_order_relaxed)) {
+        __std_atomic_notify_all_direct(&_Counter);
+    }
+}
+
+void __stdcall __std_rcu_retire(__std_reclaimable* const _Retired) noexcept {
+    auto& _Record = _Get_record();
+    auto _Head    = _Record._Retired.load(_STD memory_order_relaxed);
+    do {
+        _Retired->_Next = _Head;
+    } while (!_Record._Retired.compare_exchange_weak(
+        _Head, _Retired, _STD memory_order_release, _STD memory_order_relaxed));
+
+    if (++_Record._Retired_count < _Retired_batch) {
+        return;
+    }
+
+    _Record._Retired_count    = 0;
+    __std_reclaimable* _Ready = nullptr;
+    {
+        _STD shared_lock _Guard{_Batch_moves_mutex};
+        if (_Grace_periods_completed.load(_STD memory_order_acquire) >= _Record._Waiting_target) {
+            _Ready = _Record._Waiting.exchange(nullptr, _STD memory_order_acquire);
+            if (_Ready) {
+                _Reclaims_in_progress.fetch_add(1, _STD memory_order_relaxed);
+            }
+        }
+
+        // Only the owner closes a batch, so one that is still waiting stays until its grace period completes.
+        if (!_Record._Waiting.load(_STD memory_order_relaxed)) {
+            auto _Batch = _Record._Retired.exchange(nullptr, _STD memory_order_acquire);
+            _Take_orphaned_batches(_Batch);
+            if (_Batch) {
+                // A grace period that already started may have missed our unlinking, so wait for the next one.
+                _Record._Waiting_target = _Grace_periods_started.load(_STD memory_order_seq_cst) + 1;
+                _Record._Waiting.store(_Batch, _STD memory_order_release);
+            }
+        }
+    }
+
+    _Poll_grace_period();
+    if (_Ready) {
+        // Readers that could still see these objects finished before their grace period completed, so this is safe
+        // even inside a read-side critical section, and deleters may retire more objects.
+        _Reclaim(_Ready);
+        _Finish_reclaim();
+    }
+}
+
+void __stdcall __std_rcu_synchronize() noexcept {
+    _Synchronize();
+}
+
+void __stdcall __std_rcu_barrier() noexcept {
+    __std_reclaimable* _Batches = nullptr;
+    {
+        _STD lock_guard _Guard{_Batch_moves_mutex};
+        for (auto _Record = _Reader_records.load(_STD memory_order_acquire); _Record; _Record = _Record->_Next) {
+            _Splice_batch(_Batches, _Record->_Retired.exchange(nullptr, _STD memory_order_acquire));
+            _Splice_batch(_Batches, _Record->_Waiting.exchange(nullptr, _STD memory_order_acquire));
+        }
+    }
+
+    _Synchronize();
+    _Reclaim(_Batches);
+
+    // Batches that other threads took before we did may still be waiting for their grace period.
+    for (auto _In_progress = _Reclaims_in_progress.load(_STD memory_order_acquire); _In_progress != 0;
+         _In_progress      = _Reclaims_in_progress.load(_STD memory_order_acquire)) {
+        __std_atomic_wait_direct(
+            &_Reclaims_in_progress, &_In_progress, sizeof(_In_progress), __std_atomic_wait_no_timeout);
+    }
+}
+
+} // extern "C"
@@ -4,6 +4,7 @@
 // initialize syncstream mutex map
 
 #include <__msvc_tzdb.hpp>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <mutex>
@@ -26,8 +27,25 @@ namespace {
     using _Map_alloc = _STD _Crt_allocator<_STD pair<void* const, _Mutex_count_pair>>;
     using _Map_type  = _STD map<void*, _Mutex_count_pair, _STD less<void*>, _Map_alloc>;
 
-    _Map_type _Lookup_map;
-    _STD shared_mutex _Lookup_mutex;
+    // Each osyncstream acquires the mutex for its wrapped stream buffer on construction and releases it on destruction,
+    // so threads logging to different sinks would all serialize on a single map. Spread the instances over shards.
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    struct alignas(_STD hardware_destructive_interference_size) _Lookup_shard {
+        _STD shared_mutex _Mutex;
+        _Map_type _Map;
+    };
+#pragma warning(pop)
+
+    constexpr size_t _Shard_count_log2 = 4;
+
+    _Lookup_shard _Lookup_shards[size_t{1} << _Shard_count_log2];
+
+    [[nodiscard]] _Lookup_shard& _Get_shard(void* const _Ptr) noexcept {
+        // Fibonacci hashing; the low bits of a stream buffer's address are mostly determined by its alignment
+        const auto _Bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(_Ptr));
+        return _Lookup_shards[static_cast<size_t>((_Bits * 0x9E37'79B9'7F4A'7C15ULL) >> (64 - _Shard_count_log2))];
+    }
 } // unnamed namespace
 
 extern "C" {
@@ -36,8 +54,9 @@ extern "C" {
 // A flat C interface would return an opaque handle and would provide separate functions for locking and unlocking.
 [[nodiscard]] _STD shared_mutex* __stdcall __std_acquire_shared_mutex_for_instance(void* _Ptr) noexcept {
     try {
-        _STD scoped_lock _Guard(_Lookup_mutex);
-        auto& [_Mutex, _Refs] = _Lookup_map.try_emplace(_Ptr).first->second;
+        auto& _Shard = _Get_shard(_Ptr);
+        _STD scoped_lock _Guard(_Shard._Mutex);
+        auto& [_Mutex, _Refs] = _Shard._Map.try_emplace(_Ptr).first->second;
         ++_Refs;
         return &_Mutex;
     } catch (...) {
@@ -46,12 +65,13 @@ extern "C" {
 }
 
 void __stdcall __std_release_shared_mutex_for_instance(void* _Ptr) noexcept {
-    _STD scoped_lock _Guard(_Lookup_mutex);
-    const auto _Instance_mutex_iter = _Lookup_map.find(_Ptr);
-    _ASSERT_EXPR(_Instance_mutex_iter != _Lookup_map.end(), "No mutex exists for given instance!");
+    auto& _Shard = _Get_shard(_Ptr);
+    _STD scoped_lock _Guard(_Shard._Mutex);
+    const auto _Instance_mutex_iter = _Shard._Map.find(_Ptr);
+    _ASSERT_EXPR(_Instance_mutex_iter != _Shard._Map.end(), "No mutex exists for given instance!");
     auto& _Refs = _Instance_mutex_iter->second._Ref_count;
     if (--_Refs == 0) {
-        _Lookup_map.erase(_Instance_mutex_iter);
+        _Shard._Map.erase(_Instance_mutex_iter);
     }
 }
 
@@ -0,0 +1,384 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// implement the thread pool shared by std::async and the parallel algorithms
+
+#include <__msvc_thread_pool.hpp>
+#include <atomic>
+#include <cstddef>
+#include <execution>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <Windows.h>
+
+#include "thread_pool.hpp"
+
+namespace {
+    using _Task_deque = _STD _Work_stealing_deque<__std_thread_pool_task*>;
+
+    class _Injection_queue { // tasks submitted by threads outside the pool, in FIFO order
+    public:
+        [[nodiscard]] bool _Push(__std_thread_pool_task* const _Task, const size_t _Copies) noexcept {
+            _STD lock_guard _Guard{_Mtx};
+            if (_Ring.size() - _Size < _Copies && !_Grow(_Size + _Copies)) {
+                return false;
+            }
+
+            for (size_t _Idx = 0; _Idx < _Copies; ++_Idx) {
+                _Ring[(_First + _Size) & (_Ring.size() - 1)] = _Task;
+                ++_Size;
+            }
+
+            _Approximate_size.store(_Size, _STD memory_order_relaxed);
+            return true;
+        }
+
+        [[nodiscard]] bool _Pop(__std_thread_pool_task*& _Task) noexcept {
+            if (_Approximate_size.load(_STD memory_order_relaxed) == 0) {
+                return false;
+            }
+
+            _STD lock_guard _Guard{_Mtx};
+            if (_Size == 0) {
+                return false;
+            }
+
+            _Task  = _Ring[_First];
+            _First = (_First + 1) & (_Ring.size() - 1);
+            _Approximate_size.store(--_Size, _STD memory_order_relaxed);
+            return true;
+        }
+
+    private:
+        [[nodiscard]] bool _Grow(const size_t _Required) noexcept {
+            size_t _New_capacity = (_STD max)(_Ring.size() * 2, size_t{64});
+            while (_New_capacity < _Required) {
+                _New_capacity *= 2;
+            }
+
+            _STD vector<__std_thread_pool_task*> _New_ring;
+            try {
+                _New_ring.resize(_New_capacity);
+            } catch (...) {
+                return false;
+            }
+
+            for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+                _New_ring[_Idx] = _Ring[(_First + _Idx) & (_Ring.size() - 1)];
+            }
+
+            _Ring.swap(_New_ring);
+            _First = 0;
+            return true;
+        }
+
+        _STD mutex _Mtx;
+        _STD vector<__std_thread_pool_task*> _Ring; // capacity is zero or a power of 2
+        size_t _First = 0;
+        size_t _Size  = 0;
+        _STD atomic<size_t> _Approximate_size{0}; // lets workers skip the lock when the queue is empty
+    };
+
+    class _Thread_pool;
+
+    thread_local _Thread_pool* _This_worker_pool = nullptr;
+    thread_local size_t _This_worker_index       = 0;
+
+    class _Thread_pool {
+    public:
+        explicit _Thread_pool(const size_t _Worker_count)
+            : _Workers(new _Task_deque[_Worker_count]), _Worker_count(_Worker_count) {}
+
+        _Thread_pool(const _Thread_pool&)            = delete;
+        _Thread_pool& operator=(const _Thread_pool&) = delete;
+
+        [[nodiscard]] bool _Start() noexcept {
+            for (size_t _Idx = 0; _Idx < _Worker_count; ++_Idx) {
+                try {
+                    _STD thread{[this, _Idx] { _Worker_main(_Idx); }}.detach();
+                } catch (...) {
+                    break; // make do with the threads we have
+                }
+
+                ++_Started;
+            }
+
+            return _Started != 0;
+        }
+
+        // Queues up to _Copies pointers to _Task, returning how many were queued.
+        [[nodiscard]] size_t _Submit(__std_thread_pool_task* const _Task, const size_t _Copies) noexcept {
+            // _Queued is raised before the task becomes visible so that idle workers never undercount; see _Idle.
+            _Queued.fetch_add(_Copies);
+            const size_t _Pushed = _Push(_Task, _Copies);
+            if (_Pushed != _Copies) {
+                _Queued.fetch_sub(_Copies - _Pushed);
+            }
+
+            if (_Pushed != 0 && _Sleeping.load() != 0) {
+                _Wake_epoch.fetch_add(1);
+                if (_Pushed == 1) {
+                    __std_atomic_notify_one_direct(&_Wake_epoch);
+                } else {
+                    __std_atomic_notify_all_direct(&_Wake_epoch);
+                }
+            }
+
+            return _Pushed;
+        }
+
+        void _Get_statistics(__std_thread_pool_statistics& _Stats) const noexcept {
+            _Stats._Threads   = _Started;
+            _Stats._Queued    = _Queued.load(_STD memory_order_relaxed);
+            _Stats._Active    = _Active.load(_STD memory_order_relaxed);
+            _Stats._Completed = _Completed.load(_STD memory_order_relaxed);
+            _Stats._Steals    = _Steals.load(_STD memory_order_relaxed);
+        }
+
+    private:
+        [[nodiscard]] size_t _Push(__std_thread_pool_task* const _Task, const size_t _Copies) noexcept {
+            size_t _Pushed = 0;
+            if (_This_worker_pool == this) {
+                // Work submitted by a worker goes to the bottom of its own deque, where idle workers can steal it.
+                auto& _Local = _Workers[_This_worker_index];
+                try {
+                    for (; _Pushed < _Copies; ++_Pushed) {
+                        auto _Task_copy = _Task;
+                        _Local._Push_bottom(_Task_copy);
+                    }
+                } catch (...) {
+                    // fall back to the injection queue
+                }
+            }
+
+            if (_Pushed != _Copies && _Injected._Push(_Task, _Copies - _Pushed)) {
+                _Pushed = _Copies;
+            }
+
+            return _Pushed;
+        }
+
+        [[nodiscard]] bool _Find_task(const size_t _Index, __std_thread_pool_task*& _Task) noexcept {
+            if (_Workers[_Index]._Try_pop_bottom(_Task) || _Injected._Pop(_Task)) {
+                return true;
+            }
+
+            for (size_t _Offset = 1; _Offset < _Worker_count; ++_Offset) {
+                if (_Workers[(_Index + _Offset) % _Worker_count]._Steal(_Task)) {
+                    _Steals.fetch_add(1, _STD memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void _Idle() noexcept {
+            auto _Epoch = _Wake_epoch.load();
+            // Either _Submit observes that we are sleeping and advances _Wake_epoch, or we observe its task.
+            _Sleeping.fetch_add(1);
+            if (_Queued.load() == 0) {
+                __std_atomic_wait_direct(&_Wake_epoch, &_Epoch, sizeof(_Epoch), __std_atomic_wait_no_timeout);
+            }
+
+            _Sleeping.fetch_sub(1);
+        }
+
+        void _Worker_main(const size_t _Index) noexcept {
+            _This_worker_pool  = this;
+            _This_worker_index = _Index;
+            for (;;) {
+                __std_thread_pool_task* _Task;
+                if (!_Find_task(_Index, _Task)) {
+                    _Idle();
+                    continue;
+                }
+
+                _Queued.fetch_sub(1, _STD memory_order_relaxed);
+                _Active.fetch_add(1, _STD memory_order_relaxed);
+                _Task->_Run(_Task);
+                _Active.fetch_sub(1, _STD memory_order_relaxed);
+                _Completed.fetch_add(1, _STD memory_order_relaxed);
+            }
+        }
+
+        _STD unique_ptr<_Task_deque[]> _Workers;
+        size_t _Worker_count;
+        size_t _Started = 0;
+        _Injection_queue _Injected;
+        _STD atomic<size_t> _Queued{0};
+        _STD atomic<size_t> _Active{0};
+        _STD atomic<size_t> _Sleeping{0};
+        _STD atomic<unsigned long> _Wake_epoch{0};
+        _STD atomic<unsigned long long> _Completed{0};
+        _STD atomic<unsigned long long> _Steals{0};
+    };
+
+    // The pool is never destroyed; its threads run until the process exits.
+    _STD atomic<_Thread_pool*> _The_pool{nullptr};
+    _STD mutex _Start_mutex;
+    unsigned int _Requested_threads = 0;
+
+    [[nodiscard]] _Thread_pool* _Get_or_start_pool() noexcept {
+        if (const auto _Pool = _The_pool.load(_STD memory_order_acquire)) {
+            return _Pool;
+        }
+
+        _STD lock_guard _Guard{_Start_mutex};
+        if (const auto _Pool = _The_pool.load(_STD memory_order_relaxed)) {
+            return _Pool;
+        }
+
+        // Worker threads must not outlive this module's code, so pin it for the rest of the process.
+        HMODULE _Module;
+        if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+                reinterpret_cast<LPCWSTR>(&_Get_or_start_pool), &_Module)) {
+            return nullptr;
+        }
+
+        unsigned int _Threads = _Requested_threads;
+        if (_Threads == 0) {
+            _Threads = (_STD max)(_STD thread::hardware_concurrency(), 1u);
+        }
+
+        _Thread_pool* _Pool;
+        try {
+            _Pool = new _Thread_pool(_Threads);
+        } catch (...) {
+            return nullptr;
+        }
+
+        if (!_Pool->_Start()) {
+            delete _Pool;
+            return nullptr;
+        }
+
+        _The_pool.store(_Pool, _STD memory_order_release);
+        return _Pool;
+    }
+} // unnamed namespace
+
+struct _Thread_pool_work : __std_thread_pool_task {
+    // Each submission queues a pointer to the same object; _Pending counts those that have not yet been claimed
+    // or canceled, and _Refs keeps the object alive while any of them are queued.
+    _Thread_pool_work(const PTP_WORK_CALLBACK _Callback_, void* const _Context_) noexcept
+        : __std_thread_pool_task{&_Run}, _Callback(_Callback_), _Context(_Context_) {}
+
+    static void __stdcall _Run(__std_thread_pool_task* const _Task) noexcept {
+        const auto _Self = static_cast<_Thread_pool_work*>(_Task);
+        if (_Self->_Try_claim()) {
+            _Self->_Callback(nullptr, _Self->_Context, reinterpret_cast<PTP_WORK>(_Self));
+            _Self->_Finish(1);
+        }
+
+        _Self->_Release();
+    }
+
+    [[nodiscard]] bool _Try_claim() noexcept {
+        auto _Count = _Pending.load(_STD memory_order_relaxed);
+        while (_Count > 0) {
+            if (_Pending.compare_exchange_weak(_Count, _Count - 1, _STD memory_order_acquire)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void _Finish(const long _Count) noexcept {
+        if (_Outstanding.fetch_sub(_Count, _STD memory_order_release) == _Count) {
+            __std_atomic_notify_all_direct(&_Outstanding);
+        }
+    }
+
+    void _Release(const long _Count = 1) noexcept {
+        if (_Refs.fetch_sub(_Count, _STD memory_order_acq_rel) == _Count) {
+            delete this;
+        }
+    }
+
+    PTP_WORK_CALLBACK _Callback;
+    void* _Context;
+    _STD atomic<long> _Pending{0}; // submissions that have not started
+    _STD atomic<long> _Outstanding{0}; // submissions that have not finished or been canceled
+    _STD atomic<long> _Refs{1}; // one for the creator, plus one per queued submission
+};
+
+[[nodiscard]] _Thread_pool_work* _Create_thread_pool_work(
+    const PTP_WORK_CALLBACK _Callback, void* const _Context) noexcept {
+    if (!_The_pool.load(_STD memory_order_acquire)) {
+        return nullptr;
+    }
+
+    return new (_STD nothrow) _Thread_pool_work(_Callback, _Context);
+}
+
+void _Submit_thread_pool_work(_Thread_pool_work* const _Work, const size_t _Submissions) noexcept {
+    const auto _Count = static_cast<long>(_Submissions);
+    _Work->_Refs.fetch_add(_Count, _STD memory_order_relaxed);
+    _Work->_Outstanding.fetch_add(_Count, _STD memory_order_relaxed);
+    _Work->_Pending.fetch_add(_Count, _STD memory_order_release);
+    const auto _Pool    = _The_pool.load(_STD memory_order_acquire);
+    const auto _Dropped = _Count - static_cast<long>(_Pool->_Submit(_Work, _Submissions));
+    if (_Dropped != 0) {
+        // The parallel algorithms' callers also process the work themselves, so dropping submissions is safe.
+        long _Canceled = 0;
+        for (; _Canceled != _Dropped && _Work->_Try_claim(); ++_Canceled) {
+        }
+
+        if (_Canceled != 0) {
+            _Work->_Finish(_Canceled);
+        }
+
+        _Work->_Release(_Dropped);
+    }
+}
+
+void _Close_thread_pool_work(_Thread_pool_work* const _Work) noexcept {
+    _Work->_Release();
+}
+
+void _Wait_for_thread_pool_work_callbacks(_Thread_pool_work* const _Work, const bool _Cancel) noexcept {
+    if (_Cancel) {
+        const auto _Canceled = _Work->_Pending.exchange(0, _STD memory_order_relaxed);
+        if (_Canceled != 0) {
+            _Work->_Finish(_Canceled);
+        }
+    }
+
+    for (auto _Count = _Work->_Outstanding.load(_STD memory_order_acquire); _Count != 0;
+         _Count      = _Work->_Outstanding.load(_STD memory_order_acquire)) {
+        __std_atomic_wait_direct(&_Work->_Outstanding, &_Count, sizeof(_Count), __std_atomic_wait_no_timeout);
+    }
+}
+
+extern "C" {
+
+[[nodiscard]] bool __stdcall __std_thread_pool_set_threads(const unsigned int _Threads) noexcept {
+    _STD lock_guard _Guard{_Start_mutex};
+    if (_The_pool.load(_STD memory_order_relaxed)) {
+        return false;
+    }
+
+    _Requested_threads = _Threads;
+    return true;
+}
+
+[[nodiscard]] bool __stdcall __std_thread_pool_submit(__std_thread_pool_task* const _Task) noexcept {
+    const auto _Pool = _Get_or_start_pool();
+    return _Pool && _Pool->_Submit(_Task, 1) == 1;
+}
+
+void __stdcall __std_thread_pool_get_statistics(__std_thread_pool_statistics* const _Stats) noexcept {
+    if (const auto _Pool = _The_pool.load(_STD memory_order_acquire)) {
+        _Pool->_Get_statistics(*_Stats);
+    } else {
+        *_Stats = {};
+    }
+}
+
+} // extern "C"
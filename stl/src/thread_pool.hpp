@@ -0,0 +1,17 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <cstddef>
+
+#include <Windows.h>
+
+// Parallel algorithm work that runs on the STL thread pool instead of the Windows thread pool.
+struct _Thread_pool_work;
+
+// Returns null unless the STL thread pool has started, in which case parallel algorithms share it.
+[[nodiscard]] _Thread_pool_work* _Create_thread_pool_work(PTP_WORK_CALLBACK _Callback, void* _Context) noexcept;
+void _Submit_thread_pool_work(_Thread_pool_work* _Work, size_t _Submissions) noexcept;
+void _Close_thread_pool_work(_Thread_pool_work* _Work) noexcept;
+void _Wait_for_thread_pool_work_callbacks(_Thread_pool_work* _Work, bool _Cancel) noexcept;
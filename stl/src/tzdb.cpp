@@ -2,14 +2,23 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include <__msvc_tzdb.hpp>
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <icu.h>
 #include <internal_shared.h>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
 #include <string_view>
+#include <vector>
 #include <xfilesystem_abi.h>
 
+#include "tzif.hpp"
+
 #include <Windows.h>
 
 #pragma comment(lib, "Advapi32")
@@ -329,6 +338,363 @@ namespace {
         // a bad_alloc returns nullptr and does not set __std_tzdb_error
         return _Info->_Err == __std_tzdb_error::_Success ? nullptr : _Info.release();
     }
+
+    // TZif backend: when the TZDIR environment variable names a compiled time zone database directory (tzdata.zi
+    // plus one TZif file per zone, like /usr/share/zoneinfo), zone names and transitions come from there instead of
+    // ICU. Each zone's file is read once, on first use, into a transition table that later lookups binary search.
+    // Parsing the files and looking up periods doesn't depend on Windows, so that lives in tzif.hpp.
+
+    struct _Handle_closer {
+        void operator()(const HANDLE _Handle) const noexcept {
+            CloseHandle(_Handle);
+        }
+    };
+
+    [[nodiscard]] DWORD _Read_whole_file(const _STD wstring& _Path, _STD string& _Contents) {
+        const HANDLE _Handle = CreateFileW(_Path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_Handle == INVALID_HANDLE_VALUE) {
+            return GetLastError();
+        }
+
+        const _STD unique_ptr<void, _Handle_closer> _Guard{_Handle};
+        LARGE_INTEGER _Size;
+        if (!GetFileSizeEx(_Handle, &_Size)) {
+            return GetLastError();
+        }
+
+        if (_Size.QuadPart > 64 * 1024 * 1024) { // far larger than any real tzdata.zi or TZif file
+            return ERROR_FILE_TOO_LARGE;
+        }
+
+        _Contents.resize(static_cast<size_t>(_Size.QuadPart));
+        size_t _Done = 0;
+        while (_Done < _Contents.size()) {
+            DWORD _Read;
+            if (!ReadFile(_Handle, _Contents.data() + _Done, static_cast<DWORD>(_Contents.size() - _Done), &_Read,
+                    nullptr)) {
+                return GetLastError();
+            }
+
+            if (_Read == 0) {
+                _Contents.resize(_Done);
+                break;
+            }
+
+            _Done += _Read;
+        }
+
+        return ERROR_SUCCESS;
+    }
+
+    [[nodiscard]] bool _Is_valid_zone_name(const _STD string_view _Name) noexcept {
+        // keep lookups inside the database directory
+        if (_Name.empty() || _Name.front() == '/' || _Name.back() == '/'
+            || _Name.find("..") != _STD string_view::npos) {
+            return false;
+        }
+
+        for (const char _Ch : _Name) {
+            if (!((_Ch >= 'A' && _Ch <= 'Z') || (_Ch >= 'a' && _Ch <= 'z') || (_Ch >= '0' && _Ch <= '9') || _Ch == '/'
+                    || _Ch == '_' || _Ch == '-' || _Ch == '+' || _Ch == '.')) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    struct _Tzif_name {
+        _STD string _Name;
+        _STD string _Target; // empty for zones
+    };
+
+    class _Tzif_database {
+    public:
+        _STD wstring _Dir;
+        _STD string _Version;
+        _STD vector<_Tzif_name> _Names; // sorted by _Name
+
+        [[nodiscard]] bool _Load_names() {
+            // tzdata.zi is the whole database as zic input; only its version comment, zone lines ("Z name ..."),
+            // and link lines ("L target name") matter here
+            _STD string _Text;
+            if (_Read_whole_file(_Dir + L"\\tzdata.zi", _Text) != ERROR_SUCCESS) {
+                return false;
+            }
+
+            _STD string_view _Rest{_Text};
+            while (!_Rest.empty()) {
+                const size_t _Line_end = _Rest.find('\n');
+                _STD string_view _Line = _Rest.substr(0, _Line_end);
+                _Rest.remove_prefix(_Line_end == _STD string_view::npos ? _Rest.size() : _Line_end + 1);
+                if (!_Line.empty() && _Line.back() == '\r') {
+                    _Line.remove_suffix(1);
+                }
+
+                constexpr _STD string_view _Version_prefix = "# version ";
+                if (_Line.starts_with(_Version_prefix)) {
+                    _Version.assign(_Line.substr(_Version_prefix.size()));
+                } else if (_Line.starts_with("Z ")) {
+                    const auto _Name = _Line.substr(2, _Line.find(' ', 2) - 2);
+                    _Names.push_back({_STD string{_Name}, {}});
+                } else if (_Line.starts_with("L ")) {
+                    const size_t _Target_end = _Line.find(' ', 2);
+                    if (_Target_end == _STD string_view::npos) {
+                        return false;
+                    }
+
+                    const auto _Target = _Line.substr(2, _Target_end - 2);
+                    auto _Name         = _Line.substr(_Target_end + 1);
+                    _Name              = _Name.substr(0, _Name.find(' '));
+                    _Names.push_back({_STD string{_Name}, _STD string{_Target}});
+                }
+            }
+
+            _STD sort(_Names.begin(), _Names.end(),
+                [](const _Tzif_name& _Left, const _Tzif_name& _Right) { return _Left._Name < _Right._Name; });
+            const auto _Same_name = [](const _Tzif_name& _Left, const _Tzif_name& _Right) {
+                return _Left._Name == _Right._Name;
+            };
+            _Names.erase(_STD unique(_Names.begin(), _Names.end(), _Same_name), _Names.end());
+
+            // a link may name another link; point every one at its zone, like ICU's canonical IDs
+            for (auto& _Entry : _Names) {
+                for (size_t _Hops = 0; !_Entry._Target.empty() && _Hops < _Names.size(); ++_Hops) {
+                    const auto _Target = _Find_name(_Entry._Target);
+                    if (_Target == nullptr || _Target->_Target.empty()) {
+                        break;
+                    }
+
+                    _Entry._Target = _Target->_Target;
+                }
+            }
+
+            return !_Version.empty() && !_Names.empty();
+        }
+
+        [[nodiscard]] const _Tzif_name* _Find_name(const _STD string_view _Name) const noexcept {
+            const auto _It = _STD lower_bound(_Names.begin(), _Names.end(), _Name,
+                [](const _Tzif_name& _Entry, const _STD string_view _Key) { return _Entry._Name < _Key; });
+            return _It != _Names.end() && _It->_Name == _Name ? &*_It : nullptr;
+        }
+
+        [[nodiscard]] const _Tzif_zone* _Find_zone(const _STD string_view _Name, __std_tzdb_error& _Err) {
+            // Returns the zone's table, reading it on first use; tables are never freed, so callers can keep them.
+            // On failure, returns nullptr and sets _Err, or throws bad_alloc.
+            {
+                _STD shared_lock _Guard{_Mutex};
+                if (const auto _It = _Zones.find(_Name); _It != _Zones.end()) {
+                    return _It->second.get();
+                }
+            }
+
+            if (!_Is_valid_zone_name(_Name)) {
+                SetLastError(ERROR_FILE_NOT_FOUND);
+                _Err = __std_tzdb_error::_Win_error;
+                return nullptr;
+            }
+
+            _STD wstring _Path = _Dir;
+            _Path.push_back(L'\\');
+            for (const char _Ch : _Name) {
+                _Path.push_back(_Ch == '/' ? L'\\' : static_cast<wchar_t>(_Ch));
+            }
+
+            _STD string _Data;
+            if (const DWORD _Read_error = _Read_whole_file(_Path, _Data); _Read_error != ERROR_SUCCESS) {
+                SetLastError(_Read_error);
+                _Err = __std_tzdb_error::_Win_error;
+                return nullptr;
+            }
+
+            auto _Zone = _STD make_unique<_Tzif_zone>();
+            if (!_Parse_tzif(_Data, *_Zone)) {
+                SetLastError(ERROR_INVALID_DATA);
+                _Err = __std_tzdb_error::_Win_error;
+                return nullptr;
+            }
+
+            _STD scoped_lock _Guard{_Mutex};
+            return _Zones.try_emplace(_STD string{_Name}, _STD move(_Zone)).first->second.get();
+        }
+
+    private:
+        _STD shared_mutex _Mutex;
+        _STD map<_STD string, _STD unique_ptr<_Tzif_zone>, _STD less<>> _Zones;
+    };
+
+    enum class _Tzif_state : unsigned long {
+        _Not_set,
+        _Unavailable,
+        _Available,
+    };
+
+    _STD atomic<_Tzif_state> _Tzif_database_state{_Tzif_state::_Not_set};
+    _STD atomic<_Tzif_database*> _Tzif_database_instance{nullptr}; // set before _Tzif_database_state, never freed
+
+    [[nodiscard]] _STD unique_ptr<_Tzif_database> _Load_tzif_database() noexcept {
+        const DWORD _Dir_size = GetEnvironmentVariableW(L"TZDIR", nullptr, 0);
+        if (_Dir_size <= 1) {
+            return nullptr;
+        }
+
+        try {
+            auto _Database = _STD make_unique<_Tzif_database>();
+            _Database->_Dir.resize(_Dir_size - 1);
+            if (GetEnvironmentVariableW(L"TZDIR", _Database->_Dir.data(), _Dir_size) == _Dir_size - 1
+                && _Database->_Load_names()) {
+                return _Database;
+            }
+        } catch (...) {
+        }
+
+        return nullptr;
+    }
+
+    [[nodiscard]] _Tzif_state _Init_tzif_database() noexcept {
+        // Threads that get here at the same time each probe for the database; the first result published wins.
+        const DWORD _Last_error = GetLastError();
+        auto _Database          = _Load_tzif_database();
+        SetLastError(_Last_error); // probing for the database shouldn't disturb the ICU backend's error reporting
+
+        if (_Database) {
+            _Tzif_database* _Expected = nullptr;
+            if (_Tzif_database_instance.compare_exchange_strong(
+                    _Expected, _Database.get(), _STD memory_order_acq_rel)) {
+                (void) _Database.release();
+            } // else another thread's database was published first, and ours is freed here
+        }
+
+        const auto _Found = _Tzif_database_instance.load(_STD memory_order_acquire) != nullptr
+                              ? _Tzif_state::_Available
+                              : _Tzif_state::_Unavailable;
+        auto _State = _Tzif_state::_Not_set;
+        if (_Tzif_database_state.compare_exchange_strong(_State, _Found, _STD memory_order_acq_rel)) {
+            return _Found;
+        }
+
+        return _State; // another thread decided first
+    }
+
+    [[nodiscard]] _Tzif_database* _Acquire_tzif_database() noexcept {
+        // Returns nullptr when zone data should come from ICU.
+        auto _State = _Tzif_database_state.load(_STD memory_order_acquire);
+        if (_State == _Tzif_state::_Not_set) {
+            _State = _Init_tzif_database();
+        }
+
+        return _State == _Tzif_state::_Available ? _Tzif_database_instance.load(_STD memory_order_acquire) : nullptr;
+    }
+
+    [[nodiscard]] const char* _Allocate_copy(const _STD string_view _Str) noexcept {
+        const auto _Data = new (_STD nothrow) char[_Str.size() + 1];
+        if (_Data != nullptr) {
+            _Str.copy(_Data, _Str.size());
+            _Data[_Str.size()] = '\0';
+        }
+
+        return _Data;
+    }
+
+    [[nodiscard]] __std_tzdb_epoch_milli _Tzif_to_milli(const int64_t _Time) noexcept {
+        if (_Time == _Tzif_min_time) {
+            return U_DATE_MIN;
+        } else if (_Time == _Tzif_max_time) {
+            return U_DATE_MAX;
+        } else {
+            return static_cast<__std_tzdb_epoch_milli>(_Time) * 1000;
+        }
+    }
+
+    [[nodiscard]] int64_t _Tzif_from_milli(const __std_tzdb_epoch_milli _Time) noexcept {
+        constexpr __std_tzdb_epoch_milli _Limit = 1e18; // beyond any representable sys_seconds, which are years
+        if (!(_Time > -_Limit)) { // also maps NaN somewhere harmless
+            return static_cast<int64_t>(-_Limit / 1000);
+        } else if (_Time > _Limit) {
+            return static_cast<int64_t>(_Limit / 1000);
+        } else {
+            auto _Milli = static_cast<int64_t>(_Time); // truncates toward zero
+            if (static_cast<__std_tzdb_epoch_milli>(_Milli) > _Time) {
+                --_Milli;
+            }
+
+            return _Floor_div(_Milli, 1000);
+        }
+    }
+
+    template <class _Dx>
+    [[nodiscard]] __std_tzdb_time_zones_info* _Tzif_get_time_zones(
+        _STD unique_ptr<__std_tzdb_time_zones_info, _Dx>& _Info, const _Tzif_database& _Database) noexcept {
+        _Info->_Version        = _Database._Version.c_str();
+        _Info->_Num_time_zones = _Database._Names.size();
+        // value-init to ensure __std_tzdb_delete_time_zones() cleanup is valid
+        if (const auto _Names = new (_STD nothrow) const char*[_Info->_Num_time_zones]{}) {
+            _Info->_Names = _Names;
+        } else {
+            return nullptr;
+        }
+
+        // value-init to ensure __std_tzdb_delete_time_zones() cleanup is valid
+        if (const auto _Links = new (_STD nothrow) const char*[_Info->_Num_time_zones]{}) {
+            _Info->_Links = _Links;
+        } else {
+            return nullptr;
+        }
+
+        for (size_t _Name_idx = 0; _Name_idx < _Info->_Num_time_zones; ++_Name_idx) {
+            const auto& _Entry       = _Database._Names[_Name_idx];
+            _Info->_Names[_Name_idx] = _Allocate_copy(_Entry._Name);
+            if (_Info->_Names[_Name_idx] == nullptr) {
+                return nullptr;
+            }
+
+            if (!_Entry._Target.empty()) {
+                _Info->_Links[_Name_idx] = _Allocate_copy(_Entry._Target);
+                if (_Info->_Links[_Name_idx] == nullptr) {
+                    return nullptr;
+                }
+            }
+        }
+
+        return _Info.release();
+    }
+
+    template <class _Dx>
+    [[nodiscard]] __std_tzdb_sys_info* _Tzif_get_sys_info(_STD unique_ptr<__std_tzdb_sys_info, _Dx>& _Info,
+        _Tzif_database& _Database, const _STD string_view _Tz, const __std_tzdb_sys_info_type _Type,
+        const __std_tzdb_epoch_milli _Sys) noexcept {
+        const _Tzif_zone* _Zone;
+        try {
+            _Zone = _Database._Find_zone(_Tz, _Info->_Err);
+        } catch (...) { // bad_alloc
+            return nullptr;
+        }
+
+        if (_Zone == nullptr) {
+            return _Propagate_error(_Info);
+        }
+
+        const auto _Period = _Tzif_find_period(*_Zone, _Tzif_from_milli(_Sys));
+        _Info->_Save       = _Period._Save * 1000;
+        _Info->_Offset     = _Period._Type->_Utoff * 1000;
+        if (_Type == __std_tzdb_sys_info_type::_Offset_only) {
+            return _Info.release();
+        }
+
+        _Info->_Begin = _Tzif_to_milli(_Period._Begin);
+        _Info->_End   = _Tzif_to_milli(_Period._End);
+        if (_Type == __std_tzdb_sys_info_type::_Offset_and_range) {
+            return _Info.release();
+        }
+
+        _Info->_Abbrev = _Allocate_copy(_Period._Type->_Abbrev);
+        if (_Info->_Abbrev == nullptr) {
+            return nullptr;
+        }
+
+        return _Info.release();
+    }
 } // unnamed namespace
 
 extern "C" {
@@ -347,6 +713,10 @@ extern "C" {
         return nullptr;
     }
 
+    if (const auto _Database = _Acquire_tzif_database()) {
+        return _Tzif_get_time_zones(_Info, *_Database);
+    }
+
     if (_Acquire_icu_functions() < _Icu_api_level::_Has_icu_addresses) {
         return _Report_error(_Info, __std_tzdb_error::_Win_error);
     }
@@ -491,14 +861,18 @@ void __stdcall __std_tzdb_delete_current_zone(__std_tzdb_current_zone_info* cons
         return nullptr;
     }
 
-    if (_Acquire_icu_functions() < _Icu_api_level::_Has_icu_addresses) {
-        return _Report_error(_Info, __std_tzdb_error::_Win_error);
-    }
-
     // Get the option stored after the time zone name. If there's no option, _Tz[_Tz_len] is the null terminator in the
     // std::string, and will be treated the same as __std_tzdb_sys_info_type::_Full.
     const auto _Type = static_cast<__std_tzdb_sys_info_type>(_Tz[_Tz_len]);
 
+    if (const auto _Database = _Acquire_tzif_database()) {
+        return _Tzif_get_sys_info(_Info, *_Database, _STD string_view{_Tz, _Tz_len}, _Type, _Sys);
+    }
+
+    if (_Acquire_icu_functions() < _Icu_api_level::_Has_icu_addresses) {
+        return _Report_error(_Info, __std_tzdb_error::_Win_error);
+    }
+
     // TRANSITION, ABI
     // Profiling shows that _Get_cal is a hot path. Its result should be cached (preferably in the time_zone object).
     const auto _Cal = _Get_cal(_Tz, _Tz_len, _Info->_Err);
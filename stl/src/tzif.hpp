@@ -0,0 +1,519 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// parse TZif files and the POSIX TZ rules in their footers, and find the period that contains a time
+
+// Unlike the rest of the TZif backend in tzdb.cpp, this uses only the Standard Library, so that
+// VSO_0000000_tzif_parser can check it against the compiled time zone database of any system.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    constexpr int64_t _Tzif_min_time = INT64_MIN; // "begins at the beginning of time"
+    constexpr int64_t _Tzif_max_time = INT64_MAX; // "ends at the end of time"
+
+    struct _Tzif_type {
+        int32_t _Utoff = 0; // seconds east of UTC
+        bool _Is_dst   = false;
+        _STD string _Abbrev;
+    };
+
+    struct _Tzif_rule_date { // when a POSIX TZ rule switches, in local time
+        char _Kind    = 'M'; // 'J' for Jn (1-based, never counting February 29), 'D' for n (0-based), 'M' for Mm.w.d
+        int _Day      = 0; // day of the year for 'J' and 'D', day of the week for 'M'
+        int _Month    = 0;
+        int _Week     = 0;
+        int32_t _Time = 2 * 3600;
+    };
+
+    struct _Tzif_posix_tz {
+        _Tzif_type _Std;
+        _Tzif_type _Dst;
+        bool _Has_dst = false;
+        _Tzif_rule_date _Start; // into daylight saving time
+        _Tzif_rule_date _End; // out of daylight saving time
+    };
+
+    struct _Tzif_zone {
+        _STD vector<int64_t> _Transitions; // ascending
+        _STD vector<uint8_t> _Transition_types; // index into _Types of the type in effect from each transition on
+        _STD vector<_Tzif_type> _Types; // _Types[0] is in effect before the first transition
+        bool _Has_footer = false;
+        _Tzif_posix_tz _Footer; // in effect after the last transition
+    };
+
+    struct _Tzif_period {
+        int64_t _Begin;
+        int64_t _End;
+        const _Tzif_type* _Type;
+        int32_t _Save; // seconds
+    };
+
+    [[nodiscard]] constexpr int64_t _Floor_div(const int64_t _Num, const int64_t _Den) noexcept {
+        return _Num / _Den - (_Num % _Den < 0 ? 1 : 0);
+    }
+
+    [[nodiscard]] constexpr int64_t _Days_from_civil(int64_t _Year, const int _Month, const int _Day) noexcept {
+        // days since 1970-01-01 of a date in the proleptic Gregorian calendar
+        _Year -= _Month <= 2 ? 1 : 0;
+        const int64_t _Era      = _Floor_div(_Year, 400);
+        const int64_t _Yoe      = _Year - _Era * 400;
+        const int64_t _Doy      = (153 * (_Month > 2 ? _Month - 3 : _Month + 9) + 2) / 5 + _Day - 1;
+        const int64_t _Doe      = _Yoe * 365 + _Yoe / 4 - _Yoe / 100 + _Doy;
+        return _Era * 146097 + _Doe - 719468;
+    }
+
+    [[nodiscard]] constexpr int64_t _Year_from_days(int64_t _Days) noexcept {
+        _Days += 719468;
+        const int64_t _Era = _Floor_div(_Days, 146097);
+        const int64_t _Doe = _Days - _Era * 146097;
+        const int64_t _Yoe = (_Doe - _Doe / 1460 + _Doe / 36524 - _Doe / 146096) / 365;
+        const int64_t _Doy = _Doe - (365 * _Yoe + _Yoe / 4 - _Yoe / 100);
+        const int64_t _Mp  = (5 * _Doy + 2) / 153;
+        return _Yoe + _Era * 400 + (_Mp >= 10 ? 1 : 0);
+    }
+
+    static_assert(_Days_from_civil(1970, 1, 1) == 0);
+    static_assert(_Days_from_civil(2000, 3, 1) == 11017);
+    static_assert(_Year_from_days(11016) == 2000);
+    static_assert(_Year_from_days(-1) == 1969);
+
+    [[nodiscard]] constexpr bool _Is_leap_year(const int64_t _Year) noexcept {
+        return _Year % 4 == 0 && (_Year % 100 != 0 || _Year % 400 == 0);
+    }
+
+    [[nodiscard]] int64_t _Rule_transition(
+        const _Tzif_rule_date& _Rule, const int64_t _Year, const int32_t _Utoff_before) noexcept {
+        int64_t _Day;
+        if (_Rule._Kind == 'J') {
+            _Day = _Days_from_civil(_Year, 1, 1) + _Rule._Day - 1;
+            if (_Rule._Day >= 60 && _Is_leap_year(_Year)) {
+                ++_Day;
+            }
+        } else if (_Rule._Kind == 'D') {
+            _Day = _Days_from_civil(_Year, 1, 1) + _Rule._Day;
+        } else {
+            const int64_t _First     = _Days_from_civil(_Year, _Rule._Month, 1);
+            const int64_t _Next      = _Rule._Month == 12 ? _Days_from_civil(_Year + 1, 1, 1)
+                                                          : _Days_from_civil(_Year, _Rule._Month + 1, 1);
+            const int64_t _First_dow = _First + 4 - _Floor_div(_First + 4, 7) * 7; // 1970-01-01 was a Thursday
+            _Day = _First + (_Rule._Day - _First_dow + 7) % 7 + (_Rule._Week - 1) * 7;
+            while (_Day >= _Next) { // week 5 means the last one
+                _Day -= 7;
+            }
+        }
+
+        return _Day * 86400 + _Rule._Time - _Utoff_before;
+    }
+
+    [[nodiscard]] bool _Parse_posix_abbrev(_STD string_view& _Str, _STD string& _Abbrev) {
+        size_t _Len = 0;
+        if (!_Str.empty() && _Str[0] == '<') {
+            _Len = _Str.find('>');
+            if (_Len == _STD string_view::npos) {
+                return false;
+            }
+
+            _Abbrev.assign(_Str.substr(1, _Len - 1));
+            ++_Len;
+        } else {
+            while (_Len < _Str.size()
+                   && ((_Str[_Len] >= 'A' && _Str[_Len] <= 'Z') || (_Str[_Len] >= 'a' && _Str[_Len] <= 'z'))) {
+                ++_Len;
+            }
+
+            _Abbrev.assign(_Str.substr(0, _Len));
+        }
+
+        _Str.remove_prefix(_Len);
+        return _Abbrev.size() >= 3;
+    }
+
+    [[nodiscard]] bool _Parse_posix_time(_STD string_view& _Str, int32_t& _Seconds, const int32_t _Max_hours) noexcept {
+        // [+|-]hh[:mm[:ss]]
+        bool _Negative = false;
+        if (!_Str.empty() && (_Str[0] == '+' || _Str[0] == '-')) {
+            _Negative = _Str[0] == '-';
+            _Str.remove_prefix(1);
+        }
+
+        int32_t _Fields[3]{};
+        for (int _Field = 0; _Field < 3; ++_Field) {
+            if (_Field != 0) {
+                if (_Str.empty() || _Str[0] != ':') {
+                    break;
+                }
+
+                _Str.remove_prefix(1);
+            }
+
+            size_t _Digits = 0;
+            while (_Digits < _Str.size() && _Digits < 3 && _Str[_Digits] >= '0' && _Str[_Digits] <= '9') {
+                _Fields[_Field] = _Fields[_Field] * 10 + (_Str[_Digits] - '0');
+                ++_Digits;
+            }
+
+            if (_Digits == 0 || (_Field != 0 && (_Digits > 2 || _Fields[_Field] > 59))) {
+                return false;
+            }
+
+            _Str.remove_prefix(_Digits);
+        }
+
+        if (_Fields[0] > _Max_hours) {
+            return false;
+        }
+
+        _Seconds = _Fields[0] * 3600 + _Fields[1] * 60 + _Fields[2];
+        if (_Negative) {
+            _Seconds = -_Seconds;
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool _Parse_posix_number(
+        _STD string_view& _Str, int& _Value, const int _Min, const int _Max) noexcept {
+        size_t _Digits = 0;
+        _Value         = 0;
+        while (_Digits < _Str.size() && _Digits < 3 && _Str[_Digits] >= '0' && _Str[_Digits] <= '9') {
+            _Value = _Value * 10 + (_Str[_Digits] - '0');
+            ++_Digits;
+        }
+
+        _Str.remove_prefix(_Digits);
+        return _Digits != 0 && _Value >= _Min && _Value <= _Max;
+    }
+
+    [[nodiscard]] bool _Parse_posix_rule_date(_STD string_view& _Str, _Tzif_rule_date& _Rule) noexcept {
+        // ,Jn[/time] or ,n[/time] or ,Mm.w.d[/time]
+        if (_Str.size() < 2 || _Str[0] != ',') {
+            return false;
+        }
+
+        _Str.remove_prefix(1);
+        if (_Str[0] == 'J') {
+            _Rule._Kind = 'J';
+            _Str.remove_prefix(1);
+            if (!_Parse_posix_number(_Str, _Rule._Day, 1, 365)) {
+                return false;
+            }
+        } else if (_Str[0] == 'M') {
+            _Rule._Kind = 'M';
+            _Str.remove_prefix(1);
+            if (!_Parse_posix_number(_Str, _Rule._Month, 1, 12) || _Str.empty() || _Str[0] != '.') {
+                return false;
+            }
+
+            _Str.remove_prefix(1);
+            if (!_Parse_posix_number(_Str, _Rule._Week, 1, 5) || _Str.empty() || _Str[0] != '.') {
+                return false;
+            }
+
+            _Str.remove_prefix(1);
+            if (!_Parse_posix_number(_Str, _Rule._Day, 0, 6)) {
+                return false;
+            }
+        } else {
+            _Rule._Kind = 'D';
+            if (!_Parse_posix_number(_Str, _Rule._Day, 0, 365)) {
+                return false;
+            }
+        }
+
+        if (!_Str.empty() && _Str[0] == '/') {
+            _Str.remove_prefix(1);
+            return _Parse_posix_time(_Str, _Rule._Time, 167); // RFC 8536 3.3.1 allows -167 through 167 hours
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool _Parse_posix_tz(_STD string_view _Str, _Tzif_posix_tz& _Tz) {
+        // std offset [dst [offset] [,start[/time],end[/time]]]; offsets are west of UTC
+        int32_t _Offset;
+        if (!_Parse_posix_abbrev(_Str, _Tz._Std._Abbrev) || !_Parse_posix_time(_Str, _Offset, 24)) {
+            return false;
+        }
+
+        _Tz._Std._Utoff = -_Offset;
+        if (_Str.empty()) {
+            return true;
+        }
+
+        _Tz._Has_dst = true;
+        _Tz._Dst._Is_dst = true;
+        if (!_Parse_posix_abbrev(_Str, _Tz._Dst._Abbrev)) {
+            return false;
+        }
+
+        _Tz._Dst._Utoff = _Tz._Std._Utoff + 3600;
+        if (!_Str.empty() && _Str[0] != ',') {
+            if (!_Parse_posix_time(_Str, _Offset, 24)) {
+                return false;
+            }
+
+            _Tz._Dst._Utoff = -_Offset;
+        }
+
+        if (_Str.empty()) { // no rule; POSIX leaves this implementation-defined, zic never writes it
+            _Tz._Start = {'M', 0, 3, 2};
+            _Tz._End   = {'M', 0, 11, 1};
+            return true;
+        }
+
+        return _Parse_posix_rule_date(_Str, _Tz._Start) && _Parse_posix_rule_date(_Str, _Tz._End) && _Str.empty();
+    }
+
+    [[nodiscard]] int64_t _Read_big_endian(const unsigned char* const _Ptr, const size_t _Size) noexcept {
+        uint64_t _Value = 0;
+        for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+            _Value = (_Value << 8) | _Ptr[_Idx];
+        }
+
+        if (_Size == 4) {
+            return static_cast<int32_t>(static_cast<uint32_t>(_Value));
+        }
+
+        return static_cast<int64_t>(_Value);
+    }
+
+    [[nodiscard]] bool _Parse_tzif(const _STD string_view _Data, _Tzif_zone& _Zone) {
+        const auto _First = reinterpret_cast<const unsigned char*>(_Data.data());
+        size_t _Pos       = 0;
+
+        struct _Header {
+            char _Version;
+            size_t _Isutcnt;
+            size_t _Isstdcnt;
+            size_t _Leapcnt;
+            size_t _Timecnt;
+            size_t _Typecnt;
+            size_t _Charcnt;
+        };
+
+        const auto _Read_header = [&](_Header& _Hdr) {
+            constexpr size_t _Header_size = 44;
+            if (_Data.size() - _Pos < _Header_size || _Data.substr(_Pos, 4) != "TZif") {
+                return false;
+            }
+
+            _Hdr._Version        = _Data[_Pos + 4];
+            const auto _Counts   = _First + _Pos + 20;
+            _Hdr._Isutcnt        = static_cast<uint32_t>(_Read_big_endian(_Counts, 4));
+            _Hdr._Isstdcnt       = static_cast<uint32_t>(_Read_big_endian(_Counts + 4, 4));
+            _Hdr._Leapcnt        = static_cast<uint32_t>(_Read_big_endian(_Counts + 8, 4));
+            _Hdr._Timecnt        = static_cast<uint32_t>(_Read_big_endian(_Counts + 12, 4));
+            _Hdr._Typecnt        = static_cast<uint32_t>(_Read_big_endian(_Counts + 16, 4));
+            _Hdr._Charcnt        = static_cast<uint32_t>(_Read_big_endian(_Counts + 20, 4));
+            _Pos += _Header_size;
+            return _Hdr._Typecnt != 0 && _Hdr._Typecnt <= 256 && _Hdr._Charcnt != 0 && _Hdr._Timecnt <= 1'000'000
+                && _Hdr._Leapcnt <= 1'000'000 && _Hdr._Isstdcnt <= _Hdr._Typecnt && _Hdr._Isutcnt <= _Hdr._Typecnt;
+        };
+
+        const auto _Block_size = [](const _Header& _Hdr, const size_t _Time_size) {
+            return _Hdr._Timecnt * (_Time_size + 1) + _Hdr._Typecnt * 6 + _Hdr._Charcnt
+                 + _Hdr._Leapcnt * (_Time_size + 4) + _Hdr._Isstdcnt + _Hdr._Isutcnt;
+        };
+
+        _Header _Hdr;
+        if (!_Read_header(_Hdr)) {
+            return false;
+        }
+
+        size_t _Time_size = 4;
+        if (_Hdr._Version != '\0') { // skip the version 1 data block in favor of the 64-bit one
+            const size_t _V1_size = _Block_size(_Hdr, 4);
+            if (_Data.size() - _Pos < _V1_size) {
+                return false;
+            }
+
+            _Pos += _V1_size;
+            if (!_Read_header(_Hdr)) {
+                return false;
+            }
+
+            _Time_size = 8;
+        }
+
+        if (_Data.size() - _Pos < _Block_size(_Hdr, _Time_size)) {
+            return false;
+        }
+
+        _Zone._Transitions.resize(_Hdr._Timecnt);
+        for (auto& _Transition : _Zone._Transitions) {
+            _Transition = _Read_big_endian(_First + _Pos, _Time_size);
+            _Pos += _Time_size;
+        }
+
+        if (!_STD is_sorted(_Zone._Transitions.begin(), _Zone._Transitions.end())) {
+            return false;
+        }
+
+        _Zone._Transition_types.assign(_First + _Pos, _First + _Pos + _Hdr._Timecnt);
+        _Pos += _Hdr._Timecnt;
+        for (const auto _Type_idx : _Zone._Transition_types) {
+            if (_Type_idx >= _Hdr._Typecnt) {
+                return false;
+            }
+        }
+
+        const auto _Abbrevs = _Data.substr(_Pos + _Hdr._Typecnt * 6, _Hdr._Charcnt);
+        _Zone._Types.resize(_Hdr._Typecnt);
+        for (auto& _Type : _Zone._Types) {
+            _Type._Utoff              = static_cast<int32_t>(_Read_big_endian(_First + _Pos, 4));
+            _Type._Is_dst             = _First[_Pos + 4] != 0;
+            const size_t _Abbrev_idx = _First[_Pos + 5];
+            if (_Abbrev_idx >= _Abbrevs.size()) {
+                return false;
+            }
+
+            const auto _Abbrev = _Abbrevs.substr(_Abbrev_idx);
+            _Type._Abbrev.assign(_Abbrev.substr(0, _Abbrev.find('\0')));
+            _Pos += 6;
+        }
+
+        // leap second records only appear in the "right/" variants of the files, which this doesn't support
+        _Pos += _Hdr._Charcnt + _Hdr._Leapcnt * (_Time_size + 4) + _Hdr._Isstdcnt + _Hdr._Isutcnt;
+        if (_Hdr._Leapcnt != 0) {
+            return false;
+        }
+
+        if (_Time_size == 8) { // the footer is a POSIX TZ string between newlines, possibly empty
+            if (_Pos == _Data.size() || _Data[_Pos] != '\n') {
+                return false;
+            }
+
+            const size_t _Footer_end = _Data.find('\n', _Pos + 1);
+            if (_Footer_end == _STD string_view::npos) {
+                return false;
+            }
+
+            const auto _Footer = _Data.substr(_Pos + 1, _Footer_end - _Pos - 1);
+            if (!_Footer.empty()) {
+                if (!_Parse_posix_tz(_Footer, _Zone._Footer)) {
+                    return false;
+                }
+
+                _Zone._Has_footer = true;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] int32_t _Tzif_save(
+        const _Tzif_zone& _Zone, const size_t _Type_idx, const size_t _Transition_idx) noexcept {
+        // TZif records only whether a type is daylight saving time, not by how much, so compare with the nearest
+        // standard time with a different offset, preferring earlier ones; _Transition_idx is where _Type_idx comes
+        // into effect, or SIZE_MAX for the type in effect before the first transition
+        const auto& _Type = _Zone._Types[_Type_idx];
+        if (!_Type._Is_dst) {
+            return 0;
+        }
+
+        const auto _Is_standard = [&](const _Tzif_type& _Other) {
+            return !_Other._Is_dst && _Other._Utoff != _Type._Utoff;
+        };
+        const size_t _Count = _Zone._Transitions.size();
+        const size_t _Start = _Transition_idx == SIZE_MAX ? 0 : _Transition_idx;
+        for (size_t _Idx = _Start; _Idx-- > 0;) {
+            const auto& _Other = _Zone._Types[_Zone._Transition_types[_Idx]];
+            if (_Is_standard(_Other)) {
+                return _Type._Utoff - _Other._Utoff;
+            }
+        }
+
+        if (_Transition_idx != SIZE_MAX && _Is_standard(_Zone._Types[0])) {
+            return _Type._Utoff - _Zone._Types[0]._Utoff;
+        }
+
+        for (size_t _Idx = _Transition_idx == SIZE_MAX ? 0 : _Transition_idx + 1; _Idx < _Count; ++_Idx) {
+            const auto& _Other = _Zone._Types[_Zone._Transition_types[_Idx]];
+            if (_Is_standard(_Other)) {
+                return _Type._Utoff - _Other._Utoff;
+            }
+        }
+
+        return 3600;
+    }
+
+    [[nodiscard]] _Tzif_period _Tzif_footer_period(
+        const _Tzif_zone& _Zone, const int64_t _Time, const int64_t _Footer_begin) noexcept {
+        const auto& _Tz = _Zone._Footer;
+        if (!_Tz._Has_dst) {
+            return {_Footer_begin, _Tzif_max_time, &_Tz._Std, 0};
+        }
+
+        struct _Change {
+            int64_t _Time;
+            bool _To_dst;
+        };
+
+        // The changes of the years around _Time, sorted; at each instant only the last change counts, and a change to
+        // the state already in effect isn't one (this happens with rules that say daylight saving time lasts all year).
+        const int64_t _Year = _Year_from_days(_Floor_div(_Time + _Tz._Std._Utoff, 86400));
+        _Change _Changes[6];
+        for (int _Idx = 0; _Idx < 3; ++_Idx) {
+            _Changes[2 * _Idx]     = {_Rule_transition(_Tz._Start, _Year - 1 + _Idx, _Tz._Std._Utoff), true};
+            _Changes[2 * _Idx + 1] = {_Rule_transition(_Tz._End, _Year - 1 + _Idx, _Tz._Dst._Utoff), false};
+        }
+
+        _STD stable_sort(_STD begin(_Changes), _STD end(_Changes),
+            [](const _Change& _Left, const _Change& _Right) { return _Left._Time < _Right._Time; });
+
+        size_t _Count = 0;
+        for (const auto& _Next : _Changes) {
+            if (_Count != 0 && _Changes[_Count - 1]._Time == _Next._Time) {
+                _Changes[_Count - 1] = _Next;
+            } else {
+                _Changes[_Count++] = _Next;
+            }
+
+            if (_Count >= 2 && _Changes[_Count - 1]._To_dst == _Changes[_Count - 2]._To_dst) {
+                --_Count;
+            }
+        }
+
+        size_t _After = 0; // first change after _Time
+        while (_After < _Count && _Changes[_After]._Time <= _Time) {
+            ++_After;
+        }
+
+        const bool _Is_dst    = _After == 0 ? !_Changes[0]._To_dst : _Changes[_After - 1]._To_dst;
+        const int64_t _Begin  = _After == 0 ? _Footer_begin : (_STD max)(_Changes[_After - 1]._Time, _Footer_begin);
+        const int64_t _End    = _After == _Count ? _Tzif_max_time : _Changes[_After]._Time;
+        if (_Is_dst) {
+            return {_Begin, _End, &_Tz._Dst, _Tz._Dst._Utoff - _Tz._Std._Utoff};
+        } else {
+            return {_Begin, _End, &_Tz._Std, 0};
+        }
+    }
+
+    [[nodiscard]] _Tzif_period _Tzif_find_period(const _Tzif_zone& _Zone, const int64_t _Time) noexcept {
+        const auto& _Transitions = _Zone._Transitions;
+        const size_t _Count      = _Transitions.size();
+        const auto _Next         = _STD upper_bound(_Transitions.begin(), _Transitions.end(), _Time);
+        const auto _Idx          = static_cast<size_t>(_Next - _Transitions.begin());
+        if (_Idx == _Count && _Zone._Has_footer) {
+            return _Tzif_footer_period(_Zone, _Time, _Count == 0 ? _Tzif_min_time : _Transitions.back());
+        }
+
+        if (_Idx == 0) {
+            return {_Tzif_min_time, _Count == 0 ? _Tzif_max_time : _Transitions[0], &_Zone._Types[0],
+                _Tzif_save(_Zone, 0, SIZE_MAX)};
+        }
+
+        const size_t _Type_idx = _Zone._Transition_types[_Idx - 1];
+        return {_Transitions[_Idx - 1], _Idx == _Count ? _Tzif_max_time : _Transitions[_Idx], &_Zone._Types[_Type_idx],
+            _Tzif_save(_Zone, _Type_idx, _Idx - 1)};
+    }
+} // unnamed namespace
@@ -3096,6 +3096,12 @@ void test_lexically_normal() {
     EXPECT(path(LR"(a\..)"sv).lexically_normal().native() == LR"(.)"sv);
     EXPECT(path(LR"(a\..\)"sv).lexically_normal().native() == LR"(.)"sv);
 
+    EXPECT(path(LR"(a..\)"sv).lexically_normal().native() == LR"(a..\)"sv);
+    EXPECT(path(LR"(..\..\)"sv).lexically_normal().native() == LR"(..\..)"sv);
+    EXPECT(path(LR"(x\..\..\)"sv).lexically_normal().native() == LR"(..)"sv);
+    EXPECT(path(LR"(a\..\..\b\..)"sv).lexically_normal().native() == LR"(..)"sv);
+    EXPECT(path(LR"(C:..\a\..\)"sv).lexically_normal().native() == LR"(C:..)"sv);
+
     EXPECT(path(LR"(/\server/\share/\a/\b/\c/\./\./\d/\../\../\../\../\../\../\../\other/x/y/z/.././..\meow.txt)"sv)
                .lexically_normal()
                .native()
@@ -3118,6 +3124,9 @@ void test_lexically_relative() {
     EXPECT(path(LR"(a/b/c)"sv).lexically_relative(LR"(a/b/c)"sv).native() == LR"(.)"sv);
     EXPECT(path(LR"(a/b/c)"sv).lexically_relative(LR"(a/b/c/)"sv).native() == LR"(.)"sv);
     EXPECT(path(LR"(a/b)"sv).lexically_relative(LR"(c/d)"sv).native() == LR"(..\..\a\b)"sv);
+    EXPECT(path(LR"(a\b\)"sv).lexically_relative(LR"(a)"sv).native() == LR"(b\)"sv);
+    EXPECT(path(LR"(a/b//)"sv).lexically_relative(LR"(c)"sv).native() == LR"(..\a\b\)"sv);
+    EXPECT(path(LR"(\a)"sv).lexically_relative(LR"(a)"sv).native() == LR"(\a)"sv);
 
     EXPECT(path(LR"()"sv).lexically_relative(LR"()"sv).native() == LR"(.)"sv);
 
@@ -11,6 +11,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <deque>
 #include <forward_list>
 #include <functional>
@@ -1228,6 +1229,89 @@ namespace {
                 }
             } // namespace do_deallocate
         } // namespace mem
+
+        namespace checkpoint {
+            void test_rewind() {
+                // Verify that rewinding reuses both the memory and the chunks obtained since the checkpoint.
+                constexpr auto N = 4096_zu;
+                recording_resource rr;
+                std::pmr::monotonic_buffer_resource mbr{&rr};
+                void* const before = mbr.allocate(sizeof(void*), alignof(void*));
+
+                stdext::pmr::monotonic_checkpoint mark{mbr};
+                std::vector<void*> first(N);
+                for (auto& p : first) {
+                    p = mbr.allocate(3 * sizeof(void*), alignof(void*));
+                }
+                auto const chunks = rr.allocations_.size();
+                CHECK(chunks > 1);
+
+                for (int i = 0; i < 3; ++i) {
+                    mark.rewind();
+                    for (auto const p : first) {
+                        CHECK(mbr.allocate(3 * sizeof(void*), alignof(void*)) == p);
+                    }
+                    CHECK(rr.allocations_.size() == chunks);
+                }
+
+                // a request that no spare chunk can satisfy gets a new chunk, leaving the spares in place
+                mark.rewind();
+                auto const big = rr.allocations_.back().size * 2;
+                (void) mbr.allocate(big, alignof(void*));
+                CHECK(rr.allocations_.size() == chunks + 1);
+                for (auto i = 0_zu; i < N; ++i) {
+                    (void) mbr.allocate(3 * sizeof(void*), alignof(void*));
+                }
+                CHECK(rr.allocations_.size() == chunks + 1);
+
+                {
+                    stdext::pmr::monotonic_scope scope{mbr};
+                    void* const p = mbr.allocate(1, 1);
+                    stdext::pmr::monotonic_checkpoint inner{mbr};
+                    (void) mbr.allocate(1, 1);
+                    inner.rewind();
+                    CHECK(mbr.allocate(1, 1) == static_cast<char*>(p) + 1);
+                }
+
+                mark.rewind();
+                auto const total = rr.allocations_.size();
+                for (auto i = 0_zu; i < N; ++i) {
+                    void* const p = mbr.allocate(3 * sizeof(void*), alignof(void*));
+                    CHECK(p != before);
+                }
+                CHECK(rr.allocations_.size() == total);
+
+                mbr.release();
+                CHECK(rr.allocations_.empty());
+            }
+
+            void test_initial_buffer() {
+                // Verify that rewinding into the initial buffer reuses the chunks obtained after it was exhausted.
+                alignas(void*) char buffer[16 * sizeof(void*)];
+                recording_resource rr;
+                std::pmr::monotonic_buffer_resource mbr{buffer, sizeof(buffer), &rr};
+                auto chunks = 0_zu;
+                for (int i = 0; i < 2; ++i) {
+                    stdext::pmr::monotonic_scope scope{mbr};
+                    CHECK(mbr.allocate(sizeof(void*), alignof(void*)) == buffer);
+                    for (auto j = 0_zu; j < 256; ++j) {
+                        (void) mbr.allocate(sizeof(void*), alignof(void*));
+                    }
+
+                    if (i == 0) {
+                        chunks = rr.allocations_.size();
+                        CHECK(chunks > 1);
+                    } else {
+                        CHECK(rr.allocations_.size() == chunks);
+                    }
+                }
+            }
+
+            void test() {
+                test_rewind();
+                test_initial_buffer();
+            }
+        } // namespace checkpoint
     } // namespace monotonic
 
     namespace pool {
@@ -1378,11 +1462,39 @@ namespace {
                 analyze_geometric_growth(sizes.data(), sizes.size());
             }
 
+            void test_size_class_order() {
+                // Verify that blocks are returned to the pool they came from, regardless of the order in which
+                // the pools for the various block sizes were created.
+                constexpr std::size_t sizes[] = {64, 8, 1024, 1, 16, 4096, 256, 2};
+                recording_resource rr;
+                std::pmr::unsynchronized_pool_resource upr{{0_zu, 4096_zu}, &rr};
+
+                void* first[std::size(sizes)];
+                for (auto i = 0_zu; i < std::size(sizes); ++i) {
+                    first[i] = upr.allocate(sizes[i], 1);
+                    std::memset(first[i], static_cast<int>(i), sizes[i]);
+                }
+
+                for (auto i = std::size(sizes); i-- > 0;) {
+                    for (auto j = 0_zu; j < sizes[i]; ++j) {
+                        CHECK(static_cast<unsigned char*>(first[i])[j] == i);
+                    }
+                    upr.deallocate(first[i], sizes[i], 1);
+                }
+
+                for (auto i = 0_zu; i < std::size(sizes); ++i) {
+                    // free lists are LIFO, so reallocating in reverse order returns the same blocks
+                    void* const second = upr.allocate(sizes[i], 1);
+                    CHECK(second == first[i]);
+                }
+            }
+
             void test() {
                 test_light_allocation();
                 test_medium_allocation();
                 test_heavy_allocation();
                 test_growth();
+                test_size_class_order();
             }
         } // namespace allocate_deallocate
 
@@ -1503,6 +1615,118 @@ namespace {
         } // namespace is_equal
     } // namespace pool
 
+    namespace statistics {
+        void test_counters() {
+            recording_resource rr;
+            stdext::pmr::statistics_resource sr{&rr};
+            CHECK(sr.upstream_resource() == &rr);
+
+            const auto& stats = sr.statistics();
+            CHECK(stats.bytes_in_use == 0);
+            CHECK(stats.allocation_count == 0);
+
+            void* const p1 = sr.allocate(24, 8);
+            void* const p2 = sr.allocate(100, 64);
+            void* const p3 = sr.allocate(1, 1);
+            CHECK(rr.allocations_.size() == 3);
+            CHECK(stats.bytes_in_use == 125);
+            CHECK(stats.peak_bytes_in_use == 125);
+            CHECK(stats.allocation_count == 3);
+            CHECK(stats.allocations_by_size_class[0] == 1);
+            CHECK(stats.allocations_by_size_class[5] == 1);
+            CHECK(stats.allocations_by_size_class[7] == 1);
+            CHECK(stats.allocations_by_alignment[0] == 1);
+            CHECK(stats.allocations_by_alignment[3] == 1);
+            CHECK(stats.allocations_by_alignment[6] == 1);
+
+            sr.deallocate(p2, 100, 64);
+            CHECK(stats.bytes_in_use == 25);
+            CHECK(stats.peak_bytes_in_use == 125);
+            CHECK(stats.deallocation_count == 1);
+
+            sr.reset_statistics();
+            CHECK(stats.bytes_in_use == 25);
+            CHECK(stats.peak_bytes_in_use == 25);
+            CHECK(stats.allocation_count == 0);
+            CHECK(stats.allocations_by_size_class[5] == 0);
+
+            sr.deallocate(p1, 24, 8);
+            sr.deallocate(p3, 1, 1);
+            CHECK(stats.bytes_in_use == 0);
+            CHECK(rr.allocations_.empty());
+        }
+
+        void test_sampler() {
+            struct sample_log {
+                std::size_t count = 0;
+                void* last_ptr    = nullptr;
+            };
+
+            stdext::pmr::statistics_resource sr{std::pmr::new_delete_resource()};
+            sample_log log;
+            sr.set_sampler(
+                3,
+                [](void* context, void* ptr, std::size_t, std::size_t) {
+                    auto& l = *static_cast<sample_log*>(context);
+                    ++l.count;
+                    l.last_ptr = ptr;
+                },
+                &log);
+
+            void* ptrs[7];
+            for (auto& p : ptrs) {
+                p = sr.allocate(16);
+            }
+            CHECK(log.count == 2);
+            CHECK(log.last_ptr == ptrs[5]);
+
+            sr.set_sampler(0, nullptr);
+            for (auto& p : ptrs) {
+                sr.deallocate(p, 16);
+                p = sr.allocate(16);
+            }
+            CHECK(log.count == 2);
+
+            for (auto& p : ptrs) {
+                sr.deallocate(p, 16);
+            }
+        }
+
+        void test_as_upstream() {
+            // the statistics of an upstream resource report the chunks acquired by pool and monotonic resources
+            stdext::pmr::statistics_resource sr{std::pmr::new_delete_resource()};
+            constexpr auto idl = static_cast<std::size_t>(_ITERATOR_DEBUG_LEVEL != 0);
+            {
+                std::pmr::unsynchronized_pool_resource upr{{0_zu, 256_zu}, &sr};
+                for (int i = 0; i < 100; ++i) {
+                    (void) upr.allocate(32);
+                }
+                CHECK(sr.statistics().allocation_count > idl);
+                CHECK(sr.statistics().bytes_in_use >= 100 * 32);
+
+                upr.release();
+                CHECK(sr.statistics().bytes_in_use == idl * 2 * sizeof(void*));
+            }
+            CHECK(sr.statistics().bytes_in_use == 0);
+
+            {
+                std::pmr::monotonic_buffer_resource mbr{&sr};
+                for (int i = 0; i < 100; ++i) {
+                    (void) mbr.allocate(32);
+                }
+                CHECK(sr.statistics().bytes_in_use >= 100 * 32);
+            }
+            CHECK(sr.statistics().bytes_in_use == 0);
+            CHECK(sr.statistics().allocation_count == sr.statistics().deallocation_count);
+        }
+
+        void test() {
+            test_counters();
+            test_sampler();
+            test_as_upstream();
+        }
+    } // namespace statistics
+
     namespace containers {
         template <class T>
         void pmr_container_test() {
@@ -1635,6 +1859,7 @@ int main() {
     monotonic::mem::release::test();
     monotonic::mem::do_allocate::test();
     monotonic::mem::do_deallocate::test();
+    monotonic::checkpoint::test();
 
     pool::release::test();
     pool::upstream_resource::test();
@@ -1642,6 +1867,8 @@ int main() {
     pool::is_equal::test();
     pool::allocate_deallocate::test();
 
+    statistics::test();
+
     containers::test();
 
     map_containers::test();
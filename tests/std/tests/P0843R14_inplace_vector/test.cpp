@@ -0,0 +1,251 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <yvals_core.h>
+#if _HAS_CXX26
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <inplace_vector>
+#include <iterator>
+#include <new>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// [inplace.vector.overview]/4, /5: trivial element types give a trivially copyable inplace_vector
+static_assert(is_trivially_copyable_v<inplace_vector<int, 4>>);
+static_assert(is_trivially_destructible_v<inplace_vector<int, 4>>);
+static_assert(is_trivially_copyable_v<inplace_vector<string, 0>>);
+static_assert(!is_trivially_copyable_v<inplace_vector<string, 4>>);
+static_assert(!is_trivially_destructible_v<inplace_vector<string, 4>>);
+
+// triviality depends on copyability and destructibility only, not on default constructibility
+struct no_default {
+    explicit no_default(int) {}
+};
+static_assert(is_trivially_copyable_v<inplace_vector<no_default, 4>>);
+static_assert(is_trivially_destructible_v<inplace_vector<no_default, 4>>);
+static_assert(is_nothrow_move_constructible_v<inplace_vector<string, 4>>);
+static_assert(ranges::contiguous_range<inplace_vector<int, 4>>);
+static_assert(inplace_vector<int, 4>::capacity() == 4);
+static_assert(inplace_vector<int, 4>::max_size() == 4);
+
+constexpr bool test_constexpr() {
+    inplace_vector<int, 8> v{3, 1, 4};
+    assert(v.size() == 3);
+    v.push_back(1);
+    v.emplace_back(5);
+    assert(*v.try_push_back(9) == 9);
+    assert(v.size() == 6);
+
+    v.insert(v.begin() + 1, 2);
+    assert((v == inplace_vector<int, 8>{3, 2, 1, 4, 1, 5, 9}));
+
+    v.erase(v.begin(), v.begin() + 2);
+    assert((v == inplace_vector<int, 8>{1, 4, 1, 5, 9}));
+
+    assert(erase(v, 1) == 2);
+    assert((v == inplace_vector<int, 8>{4, 5, 9}));
+
+    auto copy = v;
+    copy.back() = 10;
+    assert(v < copy);
+    assert((v <=> copy) == strong_ordering::less);
+
+    v.resize(6, 7);
+    assert((v == inplace_vector<int, 8>{4, 5, 9, 7, 7, 7}));
+    v.resize(2);
+    assert((v == inplace_vector<int, 8>{4, 5}));
+
+    v.unchecked_push_back(6);
+    v.pop_back();
+    v.clear();
+    assert(v.empty());
+
+    inplace_vector<int, 0> none;
+    assert(none.data() == nullptr);
+    assert(none.try_push_back(1) == nullptr);
+    return true;
+}
+
+static_assert(test_constexpr());
+
+void test_capacity_errors() {
+    inplace_vector<string, 3> v{"a", "b", "c"};
+    try {
+        v.push_back("d");
+        assert(false);
+    } catch (const bad_alloc&) {
+    }
+
+    assert(v.size() == 3);
+    assert(v.try_emplace_back("d") == nullptr);
+
+    try {
+        (void) v.at(3);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    try {
+        inplace_vector<int, 2> too_many(3);
+        assert(false);
+    } catch (const bad_alloc&) {
+    }
+
+    try {
+        v.reserve(4);
+        assert(false);
+    } catch (const bad_alloc&) {
+    }
+
+    // an insertion that doesn't fit leaves the container unchanged
+    const vector<string> more{"x", "y"};
+    v.pop_back();
+    try {
+        v.insert(v.begin(), more.begin(), more.end());
+        assert(false);
+    } catch (const bad_alloc&) {
+    }
+
+    assert((v == inplace_vector<string, 3>{"a", "b"}));
+
+    // try_append_range appends as many elements as fit
+    const auto rest = v.try_append_range(more);
+    assert(rest == more.begin() + 1);
+    assert((v == inplace_vector<string, 3>{"a", "b", "x"}));
+}
+
+struct counted_thrower { // throws from the constructor that brings countdown to zero
+    static inline int live      = 0;
+    static inline int countdown = 0;
+
+    counted_thrower() {
+        tick();
+    }
+    counted_thrower(int) { // intentionally implicit, for from_range
+        tick();
+    }
+    counted_thrower(const counted_thrower&) {
+        tick();
+    }
+    counted_thrower(counted_thrower&&) {
+        tick();
+    }
+    counted_thrower& operator=(const counted_thrower&) = default;
+    ~counted_thrower() {
+        --live;
+    }
+
+    static void tick() {
+        if (countdown > 0 && --countdown == 0) {
+            throw runtime_error{"countdown"};
+        }
+
+        ++live;
+    }
+};
+
+template <class Exception, class Fn>
+void check_no_leak(const int throw_on, Fn fn) {
+    const int live_before      = counted_thrower::live;
+    counted_thrower::countdown = throw_on;
+    try {
+        fn();
+        assert(false);
+    } catch (const Exception&) {
+    }
+
+    counted_thrower::countdown = 0;
+    assert(counted_thrower::live == live_before);
+}
+
+void test_constructor_exception_safety() {
+    using V = inplace_vector<counted_thrower, 4>;
+    check_no_leak<runtime_error>(3, [] { V v(4); });
+    check_no_leak<runtime_error>(4, [] { V v(4, 0); });
+    check_no_leak<runtime_error>(2, [] { V v{1, 2, 3}; });
+
+    const int ints[]{1, 2, 3, 4, 5};
+    check_no_leak<runtime_error>(3, [&] { V v(ints, ints + 4); });
+    check_no_leak<runtime_error>(3, [&] { V v(from_range, ints | views::take(4)); });
+
+    {
+        istringstream iss{"1 2 3 4"};
+        check_no_leak<runtime_error>(4, [&] { V v(istream_iterator<int>{iss}, istream_iterator<int>{}); });
+    }
+
+    {
+        V source(3);
+        check_no_leak<runtime_error>(3, [&] { V v(source); });
+        check_no_leak<runtime_error>(2, [&] { V v(std::move(source)); });
+    }
+
+    // over-capacity input; only single-pass input can't be checked before constructing elements
+    check_no_leak<bad_alloc>(0, [&] { V v(ints, ints + 5); });
+    check_no_leak<bad_alloc>(0, [&] { V v(from_range, ints); });
+    {
+        istringstream iss{"1 2 3 4 5"};
+        check_no_leak<bad_alloc>(0, [&] { V v(istream_iterator<int>{iss}, istream_iterator<int>{}); });
+    }
+
+    {
+        istringstream iss{"1 2 3 4 5"};
+        check_no_leak<bad_alloc>(0, [&] { V v(from_range, views::istream<int>(iss)); });
+    }
+
+    assert(counted_thrower::live == 0);
+}
+
+void test_non_trivial() {
+    inplace_vector<string, 6> v(2, "meow");
+    v.insert(v.begin() + 1, {"purr", "hiss"});
+    assert((v == inplace_vector<string, 6>{"meow", "purr", "hiss", "meow"}));
+
+    v.insert(v.end(), 2, "nap");
+    assert(v.size() == 6);
+    assert(v.back() == "nap");
+
+    auto moved = std::move(v);
+    assert(moved.size() == 6);
+    moved.erase(moved.begin() + 2, moved.end());
+
+    inplace_vector<string, 6> other{"a", "b", "c"};
+    swap(moved, other);
+    assert((moved == inplace_vector<string, 6>{"a", "b", "c"}));
+    assert((other == inplace_vector<string, 6>{"meow", "purr"}));
+
+    other = moved;
+    assert(other == moved);
+    other.assign(1, "z");
+    assert((other == inplace_vector<string, 6>{"z"}));
+    other.assign_range(moved | views::reverse);
+    assert((other == inplace_vector<string, 6>{"c", "b", "a"}));
+
+    assert(erase_if(other, [](const string& s) { return s != "b"; }) == 2);
+    assert((other == inplace_vector<string, 6>{"b"}));
+
+    inplace_vector<string, 6> ranged(from_range, moved);
+    assert(ranged == moved);
+    ranged.append_range(moved);
+    assert(ranged.size() == 6);
+    assert(ranged.data() == &ranged.front());
+}
+
+int main() {
+    test_constexpr();
+    test_capacity_errors();
+    test_constructor_exception_safety();
+    test_non_trivial();
+}
+#else // ^^^ _HAS_CXX26 / !_HAS_CXX26 vvv
+int main() {}
+#endif // ^^^ !_HAS_CXX26 ^^^
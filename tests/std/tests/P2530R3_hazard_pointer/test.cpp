@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <yvals_core.h>
+#if _HAS_CXX26
+#include <atomic>
+#include <cassert>
+#include <hazard_pointer>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+static_assert(!is_copy_constructible_v<hazard_pointer>);
+static_assert(is_nothrow_move_constructible_v<hazard_pointer>);
+static_assert(is_nothrow_move_assignable_v<hazard_pointer>);
+static_assert(is_nothrow_default_constructible_v<hazard_pointer>);
+
+struct node : hazard_pointer_obj_base<node> {
+    explicit node(const int value_) : value(value_) {}
+
+    int value;
+};
+
+struct flagged_node;
+
+struct flagging_deleter {
+    bool* deleted = nullptr;
+
+    void operator()(flagged_node* ptr) const noexcept;
+};
+
+struct flagged_node : hazard_pointer_obj_base<flagged_node, flagging_deleter> {};
+
+void flagging_deleter::operator()(flagged_node* const ptr) const noexcept {
+    *deleted = true;
+    delete ptr;
+}
+
+void retire_many(const int count) {
+    // this implementation scans a thread's retired objects, along with those left by exited threads,
+    // once the larger of 64 and 2 * (hazard pointers) of them accumulate
+    for (int i = 0; i < count; ++i) {
+        (new node{i})->retire();
+    }
+}
+
+void test_hazard_pointer_object() {
+    hazard_pointer empty_hp;
+    assert(empty_hp.empty());
+
+    hazard_pointer hp = make_hazard_pointer();
+    assert(!hp.empty());
+
+    hazard_pointer moved = move(hp);
+    assert(hp.empty());
+    assert(!moved.empty());
+
+    swap(hp, moved);
+    assert(!hp.empty());
+    assert(moved.empty());
+
+    hp.swap(moved);
+    assert(hp.empty());
+    assert(!moved.empty());
+
+    hp = move(moved);
+    assert(!hp.empty());
+    assert(moved.empty());
+
+    hp = hazard_pointer{};
+    assert(hp.empty());
+}
+
+void test_protection() {
+    bool first_deleted = false;
+    atomic<flagged_node*> src{new flagged_node};
+
+    hazard_pointer hp                  = make_hazard_pointer();
+    flagged_node* const protected_node = hp.protect(src);
+    assert(protected_node == src.load());
+
+    src.store(nullptr);
+    protected_node->retire(flagging_deleter{&first_deleted});
+    retire_many(1000);
+    assert(!first_deleted); // must not be reclaimed while protected
+
+    hp.reset_protection();
+    retire_many(1000);
+    assert(first_deleted);
+
+    bool second_deleted       = false;
+    flagged_node* const other = new flagged_node;
+    src.store(other);
+    flagged_node* expected = nullptr;
+    assert(!hp.try_protect(expected, src));
+    assert(expected == other);
+    assert(hp.try_protect(expected, src));
+    hp.reset_protection(expected);
+
+    src.store(nullptr);
+    other->retire(flagging_deleter{&second_deleted});
+    retire_many(1000);
+    assert(!second_deleted);
+
+    hp.reset_protection(nullptr);
+    retire_many(1000);
+    assert(second_deleted);
+}
+
+void test_custom_deleter() {
+    bool deleted      = false;
+    hazard_pointer hp = make_hazard_pointer();
+    atomic<flagged_node*> src{new flagged_node};
+    flagged_node* const ptr = hp.protect(src);
+    src.store(nullptr);
+    ptr->retire(flagging_deleter{&deleted});
+    retire_many(1000);
+    assert(!deleted);
+
+    hp = hazard_pointer{}; // releasing the hazard pointer also ends the protection
+    retire_many(1000);
+    assert(deleted);
+}
+
+void test_retired_by_exited_thread() {
+    bool deleted = false;
+    thread([&] { (new flagged_node)->retire(flagging_deleter{&deleted}); }).join();
+    retire_many(1000);
+    assert(deleted);
+}
+
+void test_concurrent_readers() {
+    constexpr int writes  = 20'000;
+    constexpr int readers = 4;
+
+    atomic<node*> src{new node{0}};
+    atomic<bool> done{false};
+    vector<thread> threads;
+    for (int i = 0; i < readers; ++i) {
+        threads.emplace_back([&] {
+            hazard_pointer hp = make_hazard_pointer();
+            int last_seen     = 0;
+            while (!done.load()) {
+                const node* const current = hp.protect(src);
+                assert(current->value >= last_seen);
+                last_seen = current->value;
+                hp.reset_protection();
+            }
+        });
+    }
+
+    for (int i = 1; i <= writes; ++i) {
+        src.exchange(new node{i})->retire();
+    }
+
+    done.store(true);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    delete src.load();
+}
+
+int main() {
+    test_hazard_pointer_object();
+    test_protection();
+    test_custom_deleter();
+    test_retired_by_exited_thread();
+    test_concurrent_readers();
+}
+#else // ^^^ _HAS_CXX26 / !_HAS_CXX26 vvv
+int main() {}
+#endif // ^^^ !_HAS_CXX26 ^^^
@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <yvals_core.h>
+#if _HAS_CXX26
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <mutex>
+#include <rcu>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+static_assert(!is_copy_constructible_v<rcu_domain>);
+static_assert(!is_copy_assignable_v<rcu_domain>);
+static_assert(!is_default_constructible_v<rcu_domain>);
+
+atomic<int> live_configs{0};
+
+struct config : rcu_obj_base<config> {
+    explicit config(const int version_) : version(version_) {
+        ++live_configs;
+    }
+
+    config(const config&)            = delete;
+    config& operator=(const config&) = delete;
+
+    ~config() {
+        version = -1;
+        --live_configs;
+    }
+
+    int version;
+};
+
+struct counting_deleter {
+    int* count = nullptr;
+
+    void operator()(int* const ptr) const noexcept {
+        ++*count;
+        delete ptr;
+    }
+};
+
+void test_domain() {
+    rcu_domain& dom = rcu_default_domain();
+    assert(&dom == &rcu_default_domain());
+
+    dom.lock();
+    dom.lock(); // read-side critical sections nest
+    dom.unlock();
+    dom.unlock();
+
+    assert(dom.try_lock());
+    dom.unlock();
+
+    {
+        scoped_lock guard{dom};
+        unique_lock nested{dom};
+    }
+
+    rcu_synchronize();
+    rcu_synchronize(dom);
+}
+
+void test_retire() {
+    (new config{1})->retire();
+    rcu_barrier();
+    assert(live_configs.load() == 0);
+
+    int deleted = 0;
+    rcu_retire(new int{10}, counting_deleter{&deleted});
+    rcu_retire(new int{20}, counting_deleter{&deleted}, rcu_default_domain());
+    rcu_retire(new int{30});
+    rcu_barrier();
+    assert(deleted == 2);
+
+    {
+        // retiring inside a read-side critical section must not wait for it
+        scoped_lock guard{rcu_default_domain()};
+        for (int i = 0; i < 1000; ++i) {
+            (new config{i})->retire();
+        }
+    }
+
+    rcu_barrier();
+    assert(live_configs.load() == 0);
+}
+
+void test_retired_by_exited_thread() {
+    // this implementation closes objects retired by exited threads into the next full batch of 128, which is
+    // reclaimed a few batches later, once the grace periods that retirements advance have caught up with it
+    int deleted = 0;
+    thread([&] { rcu_retire(new int{40}, counting_deleter{&deleted}); }).join();
+    for (int i = 0; i < 1000; ++i) {
+        rcu_retire(new int{i});
+    }
+
+    assert(deleted == 1);
+    rcu_barrier();
+}
+
+void test_retire_does_not_wait_for_readers() {
+    // a writer may retire objects while holding a lock that a reader needs to leave its critical section
+    mutex m;
+    unique_lock writer_lock{m};
+    atomic<bool> reader_entered{false};
+    thread reader([&] {
+        scoped_lock guard{rcu_default_domain()};
+        reader_entered.store(true);
+        lock_guard reader_lock{m};
+    });
+
+    while (!reader_entered.load()) {
+        this_thread::yield();
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        (new config{i})->retire();
+    }
+
+    assert(live_configs.load() == 1000);
+    writer_lock.unlock();
+    reader.join();
+    rcu_barrier();
+    assert(live_configs.load() == 0);
+}
+
+void test_synchronize_waits_for_readers() {
+    atomic<bool> reader_entered{false};
+    atomic<bool> reader_left{false};
+
+    thread reader([&] {
+        scoped_lock guard{rcu_default_domain()};
+        reader_entered.store(true);
+        this_thread::sleep_for(100ms);
+        reader_left.store(true);
+    });
+
+    while (!reader_entered.load()) {
+        this_thread::yield();
+    }
+
+    rcu_synchronize();
+    assert(reader_left.load());
+    reader.join();
+}
+
+void test_concurrent_readers() {
+    constexpr int writes  = 5'000;
+    constexpr int readers = 4;
+
+    atomic<config*> current{new config{0}};
+    atomic<bool> done{false};
+    vector<thread> threads;
+    for (int i = 0; i < readers; ++i) {
+        threads.emplace_back([&] {
+            int last_seen = 0;
+            while (!done.load()) {
+                scoped_lock guard{rcu_default_domain()};
+                const int version = current.load()->version;
+                assert(version >= last_seen);
+                last_seen = version;
+            }
+        });
+    }
+
+    for (int i = 1; i <= writes; ++i) {
+        current.exchange(new config{i})->retire();
+    }
+
+    done.store(true);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    delete current.load();
+    rcu_barrier();
+    assert(live_configs.load() == 0);
+}
+
+int main() {
+    test_domain();
+    test_retire();
+    test_retired_by_exited_thread();
+    test_retire_does_not_wait_for_readers();
+    test_synchronize_waits_for_readers();
+    test_concurrent_readers();
+}
+#else // ^^^ _HAS_CXX26 / !_HAS_CXX26 vvv
+int main() {}
+#endif // ^^^ !_HAS_CXX26 ^^^
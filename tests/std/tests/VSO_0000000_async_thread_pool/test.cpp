@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#define _STD_ASYNC_THREAD_POOL 1
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <execution>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+constexpr unsigned int pool_size = 2;
+
+void test_results() {
+    vector<future<size_t>> futures;
+    for (size_t i = 0; i < 1000; ++i) {
+        futures.push_back(async(launch::async, [i] { return i * i; }));
+    }
+
+    for (size_t i = 0; i < futures.size(); ++i) {
+        assert(futures[i].get() == i * i);
+    }
+
+    future<string> str = async(launch::async, [] { return string(100, 'x'); });
+    assert(str.get() == string(100, 'x'));
+
+    int value      = 0;
+    future<int&> r = async(launch::async, [&value]() -> int& { return value; });
+    assert(&r.get() == &value);
+
+    future<void> v = async(launch::async, [&value] { value = 1729; });
+    v.get();
+    assert(value == 1729);
+}
+
+void test_exceptions() {
+    future<int> f = async(launch::async, []() -> int { throw runtime_error("meow"); });
+    try {
+        (void) f.get();
+        assert(false);
+    } catch (const runtime_error& e) {
+        assert(string(e.what()) == "meow");
+    }
+}
+
+size_t nested_sum(const size_t depth) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    // With more outstanding tasks than workers, a pool that blocked waiters without running their tasks would deadlock.
+    auto left  = async(launch::async, nested_sum, depth - 1);
+    auto right = async(launch::async, nested_sum, depth - 1);
+    return left.get() + right.get();
+}
+
+void test_nested_waits() {
+    assert(nested_sum(10) == 1024);
+}
+
+void test_destructor_waits() {
+    bool ran = false;
+    {
+        auto f = async(launch::async, [&ran] { ran = true; });
+    }
+
+    assert(ran);
+}
+
+void test_parallel_algorithms_share_pool() {
+    vector<int> v(100'000);
+    iota(v.rbegin(), v.rend(), 0);
+    sort(execution::par, v.begin(), v.end());
+    assert(is_sorted(v.begin(), v.end()));
+    assert(reduce(execution::par, v.begin(), v.end(), 0LL) == 99'999LL * 100'000LL / 2);
+}
+
+int main() {
+    const auto before = stdext::get_thread_pool_statistics();
+    assert(before.threads == 0);
+    assert(before.completed == 0);
+
+    assert(stdext::set_thread_pool_size(pool_size));
+
+    test_results();
+    test_exceptions();
+    test_nested_waits();
+    test_destructor_waits();
+    test_parallel_algorithms_share_pool();
+
+    const auto after = stdext::get_thread_pool_statistics();
+    assert(after.threads == pool_size);
+
+    assert(!stdext::set_thread_pool_size(4)); // the pool has already started
+}
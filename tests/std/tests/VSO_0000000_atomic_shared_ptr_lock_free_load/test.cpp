@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#define _STD_ATOMIC_SHARED_PTR_LOCK_FREE_LOAD 1
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+void test_batch_accounting() {
+    auto value = make_shared<int>(42);
+    {
+        atomic<shared_ptr<int>> a{value};
+
+        // more loads than one batch of references, all alive at once
+        vector<shared_ptr<int>> loaded;
+        for (int i = 0; i < 10000; ++i) {
+            loaded.push_back(a.load());
+            assert(loaded.back() == value);
+        }
+
+        loaded.clear();
+        assert(a.load() == value);
+
+        a.store(make_shared<int>(1729));
+        assert(value.use_count() == 1);
+        assert(*a.load() == 1729);
+
+        a.store(value);
+        for (int i = 0; i < 5000; ++i) {
+            loaded.push_back(a);
+        }
+
+        auto old = a.exchange(nullptr);
+        assert(old == value);
+        assert(value.use_count() == static_cast<long>(loaded.size()) + 2);
+        assert(a.load() == nullptr);
+    }
+
+    assert(value.use_count() == 1);
+}
+
+void test_aliasing() {
+    struct pair_of_ints {
+        int first;
+        int second;
+    };
+
+    auto owner = make_shared<pair_of_ints>(pair_of_ints{1, 2});
+    shared_ptr<int> first(owner, &owner->first);
+    shared_ptr<int> second(owner, &owner->second);
+
+    atomic<shared_ptr<int>> a{first};
+    shared_ptr<int> expected = second;
+    assert(!a.compare_exchange_strong(expected, nullptr));
+    assert(expected == first);
+    assert(a.compare_exchange_strong(expected, second));
+    assert(*a.load() == 2);
+
+    shared_ptr<int> empty_with_pointer(shared_ptr<int>{}, &owner->first);
+    a.store(empty_with_pointer);
+    const auto loaded = a.load();
+    assert(loaded.get() == &owner->first);
+    assert(loaded.use_count() == 0);
+
+    a.store(nullptr);
+    first.reset();
+    second.reset();
+    expected.reset();
+    assert(owner.use_count() == 1);
+}
+
+void test_readers_and_writer() {
+    auto first = make_shared<int>(0);
+    atomic<shared_ptr<int>> a{first};
+    atomic<bool> done{false};
+
+    vector<jthread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            int last = 0;
+            while (!done.load(memory_order_relaxed)) {
+                const auto snapshot = a.load();
+                assert(*snapshot >= last);
+                last = *snapshot;
+            }
+        });
+    }
+
+    for (int i = 1; i <= 20000; ++i) {
+        a.store(make_shared<int>(i));
+    }
+
+    done.store(true, memory_order_relaxed);
+    readers.clear();
+    assert(*a.load() == 20000);
+    assert(first.use_count() == 1);
+}
+
+void test_wait_notify() {
+    auto first = make_shared<int>(0);
+    atomic<shared_ptr<int>> a{first};
+
+    jthread waiter{[&] { a.wait(first); }};
+    a.store(make_shared<int>(1));
+    a.notify_one();
+}
+
+int main() {
+    test_batch_accounting();
+    test_aliasing();
+    test_readers_and_writer();
+    test_wait_notify();
+}
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct three_ints { // too large to wait on directly, so waits use the wait queues
+    int first;
+    int second;
+    int third;
+};
+
+static_assert(sizeof(three_ints) == 12);
+
+void test_ping_pong(const size_t pair_count) {
+    // Each pair of threads alternately waits for and notifies its own two atomics. With this many addresses,
+    // several share a table entry, and a notification must still reach the waiter on its exact address.
+    constexpr int round_count = 200;
+    vector<atomic<three_ints>> cells(pair_count * 2);
+    vector<jthread> threads;
+    for (size_t pair = 0; pair < pair_count; ++pair) {
+        auto& ping = cells[pair * 2];
+        auto& pong = cells[pair * 2 + 1];
+        threads.emplace_back([&ping, &pong] {
+            for (int i = 0; i < round_count; ++i) {
+                ping.store({i + 1, 0, 0});
+                ping.notify_one();
+                pong.wait({i, 0, 0});
+            }
+        });
+        threads.emplace_back([&ping, &pong] {
+            for (int i = 0; i < round_count; ++i) {
+                ping.wait({i, 0, 0});
+                pong.store({i + 1, 0, 0});
+                pong.notify_all();
+            }
+        });
+    }
+
+    threads.clear();
+    for (const auto& cell : cells) {
+        assert(cell.load().first == round_count);
+    }
+}
+
+size_t wait_table_index(const void* const address) { // mirrors _Atomic_wait_table_entry in atomic_wait.cpp
+    auto index = reinterpret_cast<uintptr_t>(address);
+    index ^= index >> 16;
+    index ^= index >> 8;
+    return index & 255;
+}
+
+void wait_until_queued(const unsigned long long waits) { // a wait is counted once it has joined a queue
+    while (stdext::get_atomic_wait_statistics().waits < waits) {
+        this_thread::yield();
+    }
+}
+
+void test_statistics() {
+    // runs before the other tests, so that no freed queue is available for reuse
+    const auto before = stdext::get_atomic_wait_statistics();
+
+    // with more cells than table entries, two of them share an entry
+    vector<atomic<three_ints>> cells(512);
+    atomic<three_ints>* first  = nullptr;
+    atomic<three_ints>* second = nullptr;
+    for (size_t i = 0; i < cells.size() && !second; ++i) {
+        for (size_t j = i + 1; j < cells.size(); ++j) {
+            if (wait_table_index(&cells[i]) == wait_table_index(&cells[j])) {
+                first  = &cells[i];
+                second = &cells[j];
+                break;
+            }
+        }
+    }
+
+    assert(second);
+    jthread first_waiter([first] { first->wait({0, 0, 0}); });
+    wait_until_queued(before.waits + 1);
+    jthread second_waiter([second] { second->wait({0, 0, 0}); });
+    wait_until_queued(before.waits + 2);
+
+    const auto during = stdext::get_atomic_wait_statistics();
+    assert(during.queues > before.queues);
+    assert(during.collisions > before.collisions); // the second waiter found the first one in its entry
+
+    first->store({1, 0, 0});
+    first->notify_one();
+    second->store({1, 0, 0});
+    second->notify_one();
+    first_waiter.join();
+    second_waiter.join();
+
+    const auto after = stdext::get_atomic_wait_statistics();
+    assert(after.spurious_wakeups >= before.spurious_wakeups);
+    assert(after.collisions <= after.waits);
+}
+
+int main() {
+    test_statistics();
+    test_ping_pong(1);
+    test_ping_pong(64);
+}
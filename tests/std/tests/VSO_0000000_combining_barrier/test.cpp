@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <barrier>
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+void test_phases(const int thread_count) {
+    // thread counts above the fan-in of 8 use a tree; 200 threads exceed its 64 leaves
+    constexpr int phase_count = 20;
+    atomic<int> arrivals{0};
+    int completed_phases = 0;
+
+    auto on_completion = [&]() noexcept {
+        ++completed_phases;
+        assert(arrivals.load(memory_order_relaxed) == completed_phases * thread_count);
+    };
+
+    stdext::combining_barrier<decltype(on_completion)> b(thread_count, on_completion);
+    vector<jthread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < phase_count; ++i) {
+                arrivals.fetch_add(1, memory_order_relaxed);
+                b.arrive_and_wait();
+            }
+        });
+    }
+
+    threads.clear();
+    assert(completed_phases == phase_count);
+}
+
+void test_arrive_and_wait_separately() {
+    stdext::combining_barrier<> b(2);
+    atomic<int> c{0};
+
+    jthread t1([&] {
+        for (int i = 0; i < 5; ++i) {
+            auto token = b.arrive();
+            b.wait(move(token));
+            c.fetch_add(1, memory_order_relaxed);
+        }
+    });
+
+    jthread t2([&] {
+        for (int i = 0; i < 3; ++i) {
+            b.arrive_and_wait();
+            c.fetch_add(1, memory_order_relaxed);
+        }
+
+        b.arrive_and_drop();
+    });
+
+    t1.join();
+    t2.join();
+    assert(c.load(memory_order_relaxed) == 8);
+}
+
+void test_update_spanning_leaves() {
+    int completed_phases = 0;
+    auto on_completion   = [&]() noexcept { ++completed_phases; };
+    stdext::combining_barrier<decltype(on_completion)> b(1000, on_completion);
+    for (int i = 1; i <= 5; ++i) {
+        auto first = b.arrive(400);
+        assert(completed_phases == i - 1);
+        auto second = b.arrive(600);
+        assert(completed_phases == i);
+        b.wait(move(first));
+        b.wait(move(second));
+    }
+}
+
+void test_arrive_and_drop() {
+    // thread t drops out after t % 7 phases, so the last phase has only the threads with t % 7 == 6
+    constexpr int thread_count = 50;
+    atomic<int> completed_phases{0};
+    auto on_completion = [&]() noexcept { completed_phases.fetch_add(1, memory_order_relaxed); };
+    stdext::combining_barrier<decltype(on_completion)> b(thread_count, on_completion);
+    vector<jthread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&b, t] {
+            for (int i = 0; i < t % 7; ++i) {
+                b.arrive_and_wait();
+            }
+
+            b.arrive_and_drop();
+        });
+    }
+
+    threads.clear();
+    assert(completed_phases.load(memory_order_relaxed) == 7);
+}
+
+int main() {
+    static_assert(stdext::combining_barrier<>::max() == barrier<>::max());
+
+    for (const int thread_count : {1, 2, 8, 9, 64, 200}) {
+        test_phases(thread_count);
+    }
+
+    test_arrive_and_wait_separately();
+    test_update_spanning_leaves();
+    test_arrive_and_drop();
+}
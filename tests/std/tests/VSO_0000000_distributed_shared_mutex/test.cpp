@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+void test_single_thread() {
+    stdext::distributed_shared_mutex m;
+
+    m.lock_shared();
+    assert(!m.try_lock());
+    assert(m.try_lock_shared());
+    m.unlock_shared();
+    m.unlock_shared();
+
+    m.lock();
+    assert(!m.try_lock_shared());
+    m.unlock();
+
+    assert(m.try_lock());
+    m.unlock();
+
+    {
+        shared_lock<stdext::distributed_shared_mutex> reader{m};
+        assert(reader.owns_lock());
+    }
+
+    {
+        unique_lock<stdext::distributed_shared_mutex> writer{m};
+        assert(writer.owns_lock());
+    }
+}
+
+void test_readers_and_writers() {
+    stdext::distributed_shared_mutex m;
+    int values[2]{};
+    atomic<int> readers_inside{0};
+    atomic<bool> writer_inside{false};
+
+    vector<jthread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 2000; ++j) {
+                shared_lock lock{m};
+                ++readers_inside;
+                assert(!writer_inside.load());
+                assert(values[0] == values[1]);
+                --readers_inside;
+            }
+        });
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 500; ++j) {
+                lock_guard lock{m};
+                assert(!writer_inside.exchange(true));
+                assert(readers_inside.load() == 0);
+                ++values[0];
+                ++values[1];
+                writer_inside.store(false);
+            }
+        });
+    }
+
+    threads.clear();
+    assert(values[0] == 1000);
+    assert(values[1] == 1000);
+}
+
+int main() {
+    test_single_thread();
+    test_readers_and_writers();
+}
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#define _STD_FILEBUF_LARGE_BLOCK_IO 1
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <utility>
+
+#include <temp_file_name.hpp>
+
+using namespace std;
+
+string make_contents(const size_t size) {
+    string contents(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        contents[i] = "meow\r\nWOOF\n\0\x7F\xFF"[i % 14];
+    }
+
+    return contents;
+}
+
+void write_file(const string& name, const string& contents, const ios_base::openmode mode = ios_base::trunc) {
+    ofstream out{name, ios_base::out | ios_base::binary | mode};
+    assert(out);
+    out.write(contents.data(), static_cast<streamsize>(contents.size()));
+    assert(out);
+}
+
+string read_in_chunks(ifstream& in, const size_t chunk_size) {
+    string result;
+    string chunk(chunk_size, '\0');
+    while (in.read(&chunk[0], static_cast<streamsize>(chunk_size)) || in.gcount() != 0) {
+        result.append(chunk, 0, static_cast<size_t>(in.gcount()));
+    }
+
+    return result;
+}
+
+void test_reads(const string& name, const string& contents) {
+    for (const size_t chunk_size : {1, 100, 4095, 4096, 65536, 1'000'000}) {
+        ifstream in{name, ios_base::binary};
+        assert(in);
+        assert(read_in_chunks(in, chunk_size) == contents);
+    }
+
+    { // element at a time
+        ifstream in{name, ios_base::binary};
+        string result;
+        for (int ch; (ch = in.get()) != EOF;) {
+            result.push_back(static_cast<char>(ch));
+        }
+
+        assert(result == contents);
+    }
+}
+
+void test_seeking_and_putback(const string& name, const string& contents) {
+    const auto size = static_cast<streamoff>(contents.size());
+    ifstream in{name, ios_base::binary};
+    char ch;
+    assert(in.get(ch) && ch == contents[0]);
+    assert(in.unget() && in.get(ch) && ch == contents[0]);
+    assert(in.putback(ch) && in.get(ch) && ch == contents[0]);
+
+    assert(in.seekg(size / 2) && in.tellg() == size / 2);
+    assert(in.peek() == static_cast<unsigned char>(contents[static_cast<size_t>(size / 2)]));
+    assert(in.seekg(-1, ios_base::cur) && in.tellg() == size / 2 - 1);
+    assert(in.seekg(-3, ios_base::end) && in.tellg() == size - 3);
+    assert(read_in_chunks(in, 100) == contents.substr(contents.size() - 3));
+
+    in.clear();
+    assert(in.seekg(0) && in.get(ch) && ch == contents[0]);
+    assert(in.seekg(size) && in.peek() == EOF);
+}
+
+void test_appended_data(const string& name, const string& contents) {
+    // data appended after opening is read after the rest of the file
+    ifstream in{name, ios_base::binary};
+    assert(in);
+    const string appended = make_contents(1000);
+    write_file(name, appended, ios_base::app);
+    assert(read_in_chunks(in, 5000) == contents + appended);
+}
+
+void test_move(const string& name, const string& contents) {
+    ifstream in{name, ios_base::binary};
+    string first_part(1000, '\0');
+    assert(in.read(&first_part[0], 1000));
+
+    ifstream moved{move(in)};
+    assert(read_in_chunks(moved, 777) == contents.substr(1000));
+}
+
+void test_text_mode(const string& name) {
+    const string contents = make_contents(200'000);
+    write_file(name, contents);
+
+    string translated;
+    for (size_t i = 0; i < contents.size(); ++i) {
+        if (contents[i] != '\r' || i + 1 == contents.size() || contents[i + 1] != '\n') {
+            translated.push_back(contents[i]);
+        }
+    }
+
+    ifstream in{name};
+    assert(read_in_chunks(in, 10000) == translated);
+}
+
+int main() {
+    const string name = temp_file_name();
+
+    // large enough to be mapped, small enough to be read through the C stream
+    for (const size_t size : {size_t{3'000'000}, size_t{1000}}) {
+        const string contents = make_contents(size);
+        write_file(name, contents);
+        test_reads(name, contents);
+        test_seeking_and_putback(name, contents);
+        test_move(name, contents);
+        test_appended_data(name, contents);
+    }
+
+    test_text_mode(name);
+
+    assert(remove(name.c_str()) == 0);
+}
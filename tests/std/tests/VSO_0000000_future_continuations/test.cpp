@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+#define STATIC_ASSERT(...) static_assert(__VA_ARGS__, #__VA_ARGS__)
+
+void test_then() {
+    promise<int> p;
+    future<string> chained = stdext::then(p.get_future(), [](future<int> f) { return to_string(f.get() * 2); });
+    STATIC_ASSERT(is_same_v<decltype(chained), future<string>>);
+    assert(chained.wait_for(chrono::milliseconds{0}) == future_status::timeout);
+
+    p.set_value(21);
+    assert(chained.get() == "42");
+
+    // chaining onto a future that is already ready
+    auto ready = async(launch::async, [] { return 5; });
+    ready.wait();
+    future<void> done = stdext::then(move(ready), [](future<int> f) { assert(f.get() == 5); });
+    done.get();
+
+    // reference and void results
+    int value      = 0;
+    future<int&> r = stdext::then(async(launch::async, [] {}), [&value](future<void>) -> int& { return value; });
+    future<void> v = stdext::then(move(r), [](future<int&> f) { f.get() = 1729; });
+    v.get();
+    assert(value == 1729);
+}
+
+void test_then_exceptions() {
+    promise<int> p;
+    auto rethrown = stdext::then(p.get_future(), [](future<int> f) { return f.get() + 1; });
+    p.set_exception(make_exception_ptr(runtime_error("woof")));
+    try {
+        (void) rethrown.get();
+        assert(false);
+    } catch (const runtime_error& e) {
+        assert(string(e.what()) == "woof");
+    }
+
+    auto thrown = stdext::then(async(launch::async, [] {}), [](future<void>) -> int { throw logic_error("meow"); });
+    try {
+        (void) thrown.get();
+        assert(false);
+    } catch (const logic_error& e) {
+        assert(string(e.what()) == "meow");
+    }
+
+    future<int> empty;
+    try {
+        (void) stdext::then(move(empty), [](future<int>) {});
+        assert(false);
+    } catch (const future_error& e) {
+        assert(e.code() == future_errc::no_state);
+    }
+
+    future<int> broken;
+    {
+        promise<int> abandoned;
+        broken = stdext::then(abandoned.get_future(), [](future<int> f) { return f.get(); });
+    }
+
+    try {
+        (void) broken.get();
+        assert(false);
+    } catch (const future_error& e) {
+        assert(e.code() == future_errc::broken_promise);
+    }
+}
+
+void test_then_shared_future() {
+    promise<int> p;
+    shared_future<int> sf = p.get_future().share();
+    auto first            = stdext::then(sf, [](shared_future<int> f) { return f.get() + 1; });
+    auto second           = stdext::then(sf, [](const shared_future<int>& f) { return f.get() + 2; });
+    p.set_value(10);
+    assert(first.get() == 11);
+    assert(second.get() == 12);
+    assert(sf.get() == 10);
+}
+
+void test_then_deferred_and_thread_exit() {
+    auto deferred = stdext::then(async(launch::deferred, [] { return 3; }), [](future<int> f) { return f.get() * 3; });
+    assert(deferred.get() == 9);
+
+    promise<int> p;
+    auto at_exit = stdext::then(p.get_future(), [](future<int> f) { return f.get() - 1; });
+    thread t([&p] { p.set_value_at_thread_exit(100); });
+    assert(at_exit.get() == 99);
+    t.join();
+
+    // continuations of a result made ready at thread exit mustn't occupy the pool until then
+    promise<int> late;
+    shared_future<int> late_future = late.get_future().share();
+    vector<future<int>> waiting;
+    for (unsigned int i = 0; i < (max)(thread::hardware_concurrency(), 1u); ++i) {
+        waiting.push_back(stdext::then(late_future, [](shared_future<int> f) { return f.get(); }));
+    }
+
+    thread producer([&late] {
+        late.set_value_at_thread_exit(7);
+        promise<int> ready;
+        ready.set_value(8);
+        assert(stdext::then(ready.get_future(), [](future<int> f) { return f.get(); }).get() == 8);
+    });
+
+    for (auto& f : waiting) {
+        assert(f.get() == 7);
+    }
+
+    producer.join();
+}
+
+void test_when_all() {
+    promise<int> p1;
+    promise<void> p2;
+    shared_future<string> sf = async(launch::async, [] { return string("kitty"); }).share();
+
+    auto all = stdext::when_all(p1.get_future(), p2.get_future(), sf);
+    STATIC_ASSERT(is_same_v<decltype(all), future<tuple<future<int>, future<void>, shared_future<string>>>>);
+    assert(sf.valid()); // shared_futures are copied
+    p2.set_value();
+    assert(all.wait_for(chrono::milliseconds{0}) == future_status::timeout);
+    p1.set_value(7);
+
+    auto results = all.get();
+    assert(get<0>(results).get() == 7);
+    get<1>(results).get();
+    assert(get<2>(results).get() == "kitty");
+
+    vector<future<size_t>> futures;
+    for (size_t i = 0; i < 100; ++i) {
+        futures.push_back(async(launch::async, [i] { return i; }));
+    }
+
+    auto range = stdext::when_all(futures.begin(), futures.end());
+    for (const auto& f : futures) {
+        assert(!f.valid()); // futures are moved
+    }
+
+    auto collected = range.get();
+    assert(collected.size() == 100);
+    for (size_t i = 0; i < collected.size(); ++i) {
+        assert(collected[i].get() == i);
+    }
+
+    assert(stdext::when_all().get() == tuple<>{});
+    vector<future<int>> none;
+    assert(stdext::when_all(none.begin(), none.end()).get().empty());
+}
+
+void test_when_any() {
+    promise<int> slow;
+    promise<int> fast;
+    auto any = stdext::when_any(slow.get_future(), fast.get_future());
+    STATIC_ASSERT(is_same_v<decltype(any), future<stdext::when_any_result<tuple<future<int>, future<int>>>>>);
+    fast.set_value(2);
+
+    auto result = any.get();
+    assert(result.index == 1);
+    assert(get<1>(result.futures).get() == 2);
+    slow.set_value(1);
+    assert(get<0>(result.futures).get() == 1);
+
+    vector<promise<int>> promises(10);
+    vector<shared_future<int>> futures;
+    for (auto& p : promises) {
+        futures.push_back(p.get_future().share());
+    }
+
+    auto range = stdext::when_any(futures.begin(), futures.end());
+    promises[6].set_value(6);
+    auto first = range.get();
+    assert(first.index == 6);
+    assert(first.futures.size() == 10);
+    assert(first.futures[6].get() == 6);
+    for (size_t i = 0; i < promises.size(); ++i) {
+        if (i != 6) {
+            promises[i].set_value(static_cast<int>(i));
+        }
+    }
+
+    vector<future<int>> none;
+    auto empty = stdext::when_any(none.begin(), none.end()).get();
+    assert(empty.index == static_cast<size_t>(-1));
+    assert(empty.futures.empty());
+}
+
+int main() {
+    test_then();
+    test_then_exceptions();
+    test_then_shared_future();
+    test_then_deferred_and_thread_exit();
+    test_when_all();
+    test_when_any();
+}
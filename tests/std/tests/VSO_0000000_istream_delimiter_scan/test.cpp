@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// getline() and ignore() consume whole runs of the get area at once; check that they still behave
+// exactly like extracting one character at a time, which is what they do for unbuffered stream buffers.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <ios>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// exposes the characters of a string through a get area that never holds more than chunk characters,
+// or through underflow() and uflow() alone when chunk is 0
+template <class CharT, class Traits = char_traits<CharT>>
+class chunked_buf : public basic_streambuf<CharT, Traits> {
+public:
+    using int_type = typename Traits::int_type;
+
+    chunked_buf(basic_string<CharT, Traits> text, const size_t chunk) : text_(move(text)), chunk_(chunk) {}
+
+protected:
+    int_type underflow() override {
+        if (chunk_ == 0) {
+            return pos_ == text_.size() ? Traits::eof() : Traits::to_int_type(text_[pos_]);
+        }
+
+        if (this->gptr() != this->egptr()) {
+            return Traits::to_int_type(*this->gptr());
+        }
+
+        if (pos_ == text_.size()) {
+            return Traits::eof();
+        }
+
+        const size_t count = (min) (chunk_, text_.size() - pos_);
+        CharT* const first = &text_[pos_]; // not data(), which returns const CharT* before C++17
+        this->setg(first, first, first + count);
+        pos_ += count;
+        return Traits::to_int_type(*first);
+    }
+
+    int_type uflow() override {
+        if (chunk_ != 0) {
+            return basic_streambuf<CharT, Traits>::uflow();
+        }
+
+        return pos_ == text_.size() ? Traits::eof() : Traits::to_int_type(text_[pos_++]);
+    }
+
+private:
+    basic_string<CharT, Traits> text_;
+    size_t chunk_;
+    size_t pos_ = 0;
+};
+
+template <class CharT, class Traits>
+struct extraction_result {
+    vector<basic_string<CharT, Traits>> lines;
+    vector<streamsize> counts;
+    vector<ios_base::iostate> states;
+
+    bool operator==(const extraction_result& other) const {
+        return lines == other.lines && counts == other.counts && states == other.states;
+    }
+};
+
+template <class CharT, class Traits>
+extraction_result<CharT, Traits> extract_all(const basic_string<CharT, Traits>& text, const size_t chunk) {
+    // cycle through the kinds of extraction, with limits that sometimes cut lines short
+    extraction_result<CharT, Traits> result;
+    chunked_buf<CharT, Traits> buf{text, chunk};
+    basic_istream<CharT, Traits> is{&buf};
+    const CharT delim = is.widen('\n');
+    CharT buffer[24];
+    for (size_t step = 0; is.good(); ++step) {
+        basic_string<CharT, Traits> line;
+        switch (step % 5) {
+        case 0:
+            getline(is, line, delim);
+            result.counts.push_back(static_cast<streamsize>(line.size()));
+            break;
+        case 1:
+        case 2:
+            is.getline(buffer, step % 5 == 1 ? 24 : 3, delim);
+            line = buffer;
+            result.counts.push_back(is.gcount());
+            is.clear(is.rdstate() & ~ios_base::failbit);
+            break;
+        case 3:
+            is.ignore(static_cast<streamsize>(step % 40), Traits::to_int_type(delim));
+            result.counts.push_back(is.gcount());
+            break;
+        case 4:
+            is.ignore((numeric_limits<streamsize>::max)(), Traits::to_int_type(delim));
+            result.counts.push_back(is.gcount());
+            break;
+        }
+
+        result.lines.push_back(move(line));
+        result.states.push_back(is.rdstate());
+    }
+
+    return result;
+}
+
+template <class CharT, class Traits>
+void test_matches_unbuffered(const basic_string<CharT, Traits>& text) {
+    const auto expected = extract_all(text, 0);
+    for (const size_t chunk : {size_t{1}, size_t{7}, size_t{64}, size_t{1000}}) {
+        assert(extract_all(text, chunk) == expected);
+    }
+}
+
+template <class CharT, class Traits = char_traits<CharT>>
+basic_string<CharT, Traits> make_text() {
+    // lines of every length up to well past a vector register, some of them blank
+    basic_string<CharT, Traits> text;
+    for (size_t line = 0; line < 150; ++line) {
+        for (size_t i = 0; i < line % 75; ++i) {
+            text.push_back(static_cast<CharT>('a' + (line + i) % 26));
+        }
+
+        text.push_back(static_cast<CharT>('\n'));
+    }
+
+    text.append(100, static_cast<CharT>('z')); // no final delimiter
+    return text;
+}
+
+// user-defined traits always take the one-character-at-a-time path
+struct user_traits : char_traits<char> {};
+
+void test_string_getline() {
+    istringstream is{string(100, 'x') + "\nabc"};
+    string line;
+    assert(getline(is, line));
+    assert(line == string(100, 'x'));
+    assert(getline(is, line));
+    assert(line == "abc");
+    assert(is.eof() && !is.fail());
+    assert(!getline(is, line));
+}
+
+void test_wchar_t_eof_element() {
+    // L'\xFFFF' reads as WEOF, so it has always ended extraction like the end of the stream would
+    const wstring text = wstring(40, L'w') + L'\xFFFF' + wstring(40, L'w') + L'\n';
+    for (const size_t chunk : {size_t{0}, size_t{100}}) {
+        chunked_buf<wchar_t> buf{text, chunk};
+        wistream is{&buf};
+        wstring line;
+        getline(is, line);
+        assert(line == wstring(40, L'w'));
+        assert(is.eof());
+    }
+}
+
+int main() {
+    test_matches_unbuffered(make_text<char>());
+    test_matches_unbuffered(make_text<wchar_t>());
+    test_matches_unbuffered(make_text<char, user_traits>());
+
+    string high_bytes = make_text<char>();
+    for (size_t i = 0; i < high_bytes.size(); i += 13) {
+        high_bytes[i] = '\xFF'; // must not be mistaken for EOF
+    }
+    test_matches_unbuffered(high_bytes);
+
+    test_string_getline();
+    test_wchar_t_eof_element();
+}
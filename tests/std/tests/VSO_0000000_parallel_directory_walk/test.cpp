@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <__msvc_thread_pool.hpp>
+#include <test_filesystem_support.hpp>
+
+using namespace std;
+using namespace std::filesystem;
+
+void make_tree(const path& dir, const int depth) {
+    for (int i = 0; i < 4; ++i) {
+        ofstream{dir / ("file" + to_string(i) + ".txt")} << "meow";
+    }
+
+    if (depth != 0) {
+        for (int i = 0; i < 3; ++i) {
+            const path subdir = dir / ("dir" + to_string(i));
+            create_directory(subdir);
+            make_tree(subdir, depth - 1);
+        }
+    }
+}
+
+vector<path> sorted_recursive_listing(const path& root) {
+    vector<path> result;
+    for (const auto& entry : recursive_directory_iterator{root}) {
+        result.push_back(entry.path());
+    }
+
+    sort(result.begin(), result.end());
+    return result;
+}
+
+struct collector {
+    mutex mtx;
+    vector<path> paths;
+
+    void add(const directory_entry& entry) {
+        lock_guard lck{mtx};
+        paths.push_back(entry.path());
+    }
+
+    vector<path> sorted() {
+        sort(paths.begin(), paths.end());
+        return paths;
+    }
+};
+
+void test_matches_recursive_directory_iterator(const path& root) {
+    collector visited;
+    stdext::parallel_directory_walk(root, [&](const directory_entry& entry) {
+        // attributes are cached from reading the directory
+        assert(entry.is_directory() == (entry.path().extension() != ".txt"));
+        visited.add(entry);
+    });
+
+    assert(visited.sorted() == sorted_recursive_listing(root));
+}
+
+void test_pruning(const path& root) {
+    collector visited;
+    stdext::parallel_directory_walk(root, [&](const directory_entry& entry) {
+        visited.add(entry);
+        return entry.path().filename() != "dir1";
+    });
+
+    // every directory named dir1 is visited, but its contents aren't
+    const auto is_pruned = [&](const path& p) {
+        const path parent = p.parent_path().lexically_relative(root);
+        return find(parent.begin(), parent.end(), path{"dir1"}) != parent.end();
+    };
+
+    vector<path> expected = sorted_recursive_listing(root);
+    expected.erase(remove_if(expected.begin(), expected.end(), is_pruned), expected.end());
+    assert(visited.sorted() == expected);
+}
+
+void test_errors(const path& root) {
+    const path missing = root / "missing";
+    atomic<int> calls{0};
+    error_code ec;
+    stdext::parallel_directory_walk(missing, directory_options::none, [&](const directory_entry&) { ++calls; }, ec);
+    assert(ec);
+    assert(calls == 0);
+
+    try {
+        stdext::parallel_directory_walk(missing, [&](const directory_entry&) { ++calls; });
+        assert(false);
+    } catch (const filesystem_error& e) {
+        assert(e.path1() == missing);
+    }
+
+    try {
+        stdext::parallel_directory_walk(root, [](const directory_entry& entry) {
+            if (entry.path().filename() == "file2.txt") {
+                throw runtime_error{"woof"};
+            }
+        });
+        assert(false);
+    } catch (const runtime_error& e) {
+        assert(e.what() == string{"woof"});
+    }
+}
+
+atomic<int> pool_walks_finished{0};
+
+struct walk_on_pool_thread : __std_thread_pool_task {
+    const path* root;
+    const vector<path>* expected;
+
+    static void __stdcall run(__std_thread_pool_task* const task) noexcept {
+        const auto& self = static_cast<const walk_on_pool_thread&>(*task);
+        collector visited;
+        stdext::parallel_directory_walk(*self.root, [&](const directory_entry& entry) { visited.add(entry); });
+        assert(visited.sorted() == *self.expected);
+        ++pool_walks_finished;
+        pool_walks_finished.notify_all();
+    }
+};
+
+void test_called_from_pool_threads(const path& root) {
+    // more walks than pool threads, so every pool thread is busy with a walk and none is free to help
+    const vector<path> expected = sorted_recursive_listing(root);
+    walk_on_pool_thread walks[4];
+    for (auto& walk : walks) {
+        walk._Run     = &walk_on_pool_thread::run;
+        walk.root     = &root;
+        walk.expected = &expected;
+        const bool submitted = __std_thread_pool_submit(&walk);
+        assert(submitted);
+    }
+
+    for (int finished = pool_walks_finished.load(); finished != 4; finished = pool_walks_finished.load()) {
+        pool_walks_finished.wait(finished);
+    }
+}
+
+int main() {
+    // must precede the pool's first use
+    const bool set_threads = __std_thread_pool_set_threads(2);
+    assert(set_threads);
+
+    const test_temp_directory temp_dir{"parallel_directory_walk"};
+    const path& root = temp_dir.directoryPath;
+    make_tree(root, 3);
+
+    test_matches_recursive_directory_iterator(root);
+    test_pruning(root);
+    test_errors(root);
+    test_called_from_pool_threads(root);
+}
@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <temp_file_name.hpp>
+
+using namespace std;
+
+// formatting this prints nothing, but print_batch can't know that, so it formats into a string first
+struct not_nonlocking {
+    int value;
+};
+
+template <>
+struct formatter<not_nonlocking> : formatter<int> {
+    auto format(const not_nonlocking& val, format_context& ctx) const {
+        return formatter<int>::format(val.value, ctx);
+    }
+};
+
+static_assert(!enable_nonlocking_formatter_optimization<not_nonlocking>);
+
+class temp_file {
+public:
+    temp_file() : name_(temp_file_name()) {
+        const errno_t err = fopen_s(&stream_, name_.c_str(), "w+b");
+        assert(err == 0);
+    }
+
+    ~temp_file() {
+        fclose(stream_);
+        filesystem::remove(name_);
+    }
+
+    temp_file(const temp_file&)            = delete;
+    temp_file& operator=(const temp_file&) = delete;
+
+    FILE* stream() const {
+        return stream_;
+    }
+
+    string contents() const {
+        fflush(stream_);
+        rewind(stream_);
+        string result;
+        for (int ch; (ch = fgetc(stream_)) != EOF;) {
+            result.push_back(static_cast<char>(ch));
+        }
+
+        return result;
+    }
+
+private:
+    string name_;
+    FILE* stream_ = nullptr;
+};
+
+void test_output() {
+    temp_file file;
+    {
+        stdext::print_batch batch{file.stream()};
+        batch.print("no arguments, {{braces}}");
+        batch.println();
+        batch.println("{} and {:>5}", 42, "str"sv);
+        batch.print("{:04}", not_nonlocking{7});
+        fputs(" fputs ", file.stream()); // same thread, so it can still write, and lands in order
+        batch.println("{}", not_nonlocking{8});
+        batch.println("{}", string(5000, 'x')); // longer than the formatting buffer
+        batch.println("last");
+    }
+
+    print(file.stream(), "after");
+
+    const string expected =
+        "no arguments, {braces}\n42 and   str\n0007 fputs 8\n" + string(5000, 'x') + "\nlast\nafter";
+    assert(file.contents() == expected);
+}
+
+void test_batches_do_not_interleave() {
+    constexpr int thread_count = 8;
+    constexpr int batch_count  = 50;
+    constexpr int line_count   = 5;
+
+    temp_file file;
+    {
+        vector<jthread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&file, t] {
+                for (int b = 0; b < batch_count; ++b) {
+                    stdext::print_batch batch{file.stream()};
+                    for (int line = 0; line < line_count; ++line) {
+                        batch.println("{} {} {}", t, b, line);
+                    }
+                }
+            });
+        }
+    }
+
+    const string contents = file.contents();
+    size_t pos            = 0;
+    for (int i = 0; i < thread_count * batch_count; ++i) {
+        int t = -1;
+        int b = -1;
+        for (int line = 0; line < line_count; ++line) {
+            const size_t end = contents.find('\n', pos);
+            assert(end != string::npos);
+            int this_t;
+            int this_b;
+            int this_line;
+            const string text = contents.substr(pos, end - pos);
+            const int fields  = sscanf_s(text.c_str(), "%d %d %d", &this_t, &this_b, &this_line);
+            assert(fields == 3);
+            assert(this_line == line);
+            if (line == 0) {
+                t = this_t;
+                b = this_b;
+            } else {
+                assert(this_t == t && this_b == b);
+            }
+
+            pos = end + 1;
+        }
+    }
+
+    assert(pos == contents.size());
+}
+
+int main() {
+    test_output();
+    test_batches_do_not_interleave();
+}
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#define _STD_STOP_CALLBACK_LOCK_FREE 1
+
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+void test_deregistration_orders() {
+    stop_source source;
+    int calls       = 0;
+    auto count_call = [&calls] { ++calls; };
+    using counting_callback = stop_callback<decltype(count_call)>;
+
+    { // reverse order of registration, unlinking the head each time
+        counting_callback first{source.get_token(), count_call};
+        counting_callback second{source.get_token(), count_call};
+        counting_callback third{source.get_token(), count_call};
+    }
+
+    { // order of registration, unlinking the last one each time
+        optional<counting_callback> first{in_place, source.get_token(), count_call};
+        optional<counting_callback> second{in_place, source.get_token(), count_call};
+        optional<counting_callback> third{in_place, source.get_token(), count_call};
+        first.reset();
+        second.reset();
+        third.reset();
+    }
+
+    { // the middle one, then stop calls the rest
+        counting_callback first{source.get_token(), count_call};
+        optional<counting_callback> second{in_place, source.get_token(), count_call};
+        counting_callback third{source.get_token(), count_call};
+        second.reset();
+        assert(calls == 0);
+        assert(source.request_stop());
+        assert(calls == 2);
+    }
+
+    // registering after stop calls the callback immediately
+    counting_callback late{source.get_token(), count_call};
+    assert(calls == 3);
+}
+
+void test_callbacks_destroyed_by_callbacks() {
+    stop_source source;
+    optional<stop_callback<function<void()>>> self;
+    optional<stop_callback<function<void()>>> other;
+    other.emplace(source.get_token(), [] { assert(false); });
+    self.emplace(source.get_token(), [&] {
+        other.reset();
+        self.reset();
+    });
+
+    assert(source.request_stop());
+    assert(!self.has_value());
+    assert(!other.has_value());
+}
+
+void test_concurrent_churn() {
+    // Threads register and deregister callbacks in assorted orders while another thread requests stop.
+    // Every callback that was registered when stop was requested must be called exactly once.
+    constexpr int thread_count    = 8;
+    constexpr int iteration_count = 2000;
+    for (int round = 0; round < 10; ++round) {
+        stop_source source;
+        atomic<int> kept_calls{0};
+        atomic<int> ready{0};
+        vector<jthread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t] {
+                const auto token = source.get_token();
+                stop_callback kept{token, [&kept_calls] { kept_calls.fetch_add(1); }};
+                ready.fetch_add(1);
+                for (int i = 0; i < iteration_count; ++i) {
+                    atomic<int> calls{0};
+                    optional<stop_callback<function<void()>>> older{in_place, token, [&calls] { calls.fetch_add(1); }};
+                    stop_callback newer{token, [&calls] { calls.fetch_add(1); }};
+                    if ((i + t) % 2 == 0) {
+                        older.reset(); // not the head, unless newer was taken by stop
+                    }
+
+                    assert(calls.load() <= 2);
+                }
+
+                // keep the first callback registered until stop has been requested
+                for (int seen = ready.load(); seen != thread_count + 1; seen = ready.load()) {
+                    ready.wait(seen);
+                }
+            });
+        }
+
+        while (ready.load() != thread_count) {
+            this_thread::yield();
+        }
+
+        assert(source.request_stop());
+        assert(kept_calls.load() == thread_count);
+        ready.fetch_add(1);
+        ready.notify_all();
+    }
+}
+
+int main() {
+    test_deregistration_orders();
+    test_callbacks_destroyed_by_callbacks();
+    test_concurrent_churn();
+}
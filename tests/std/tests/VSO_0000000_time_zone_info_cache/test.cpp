@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#define _STD_TIME_ZONE_INFO_CACHE 1
+
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+// Since 2007, America/Los_Angeles has observed PDT (UTC-7) from the second Sunday in March at 02:00 PST
+// until the first Sunday in November at 02:00 PDT, and PST (UTC-8) otherwise.
+
+sys_seconds dst_start(const int y) {
+    return sys_days{year{y} / March / Sunday[2]} + 10h;
+}
+
+sys_seconds dst_end(const int y) {
+    return sys_days{year{y} / November / Sunday[1]} + 9h;
+}
+
+void check_info(const time_zone& zone, const sys_seconds when) {
+    const int y          = static_cast<int>(year_month_day{floor<days>(when)}.year());
+    const sys_info info  = zone.get_info(when);
+    const bool is_dst    = when >= dst_start(y) && when < dst_end(y);
+    const auto local_now = zone.to_local(when);
+    if (is_dst) {
+        assert(info.begin == dst_start(y));
+        assert(info.end == dst_end(y));
+        assert(info.offset == -7h);
+        assert(info.save == 60min);
+        assert(info.abbrev == "PDT");
+    } else if (when < dst_start(y)) {
+        assert(info.begin == dst_end(y - 1));
+        assert(info.end == dst_start(y));
+    } else {
+        assert(info.begin == dst_end(y));
+        assert(info.end == dst_start(y + 1));
+    }
+
+    if (!is_dst) {
+        assert(info.offset == -8h);
+        assert(info.save == 0min);
+        assert(info.abbrev == "PST");
+    }
+
+    assert(local_now == local_seconds{when.time_since_epoch() + info.offset});
+}
+
+void test_repeated_lookups(const time_zone& zone) {
+    for (int round = 0; round < 3; ++round) { // the first round fills the cache, later ones read it
+        for (int y = 2010; y <= 2020; ++y) {
+            check_info(zone, dst_start(y) - 1s);
+            check_info(zone, dst_start(y));
+            check_info(zone, sys_days{year{y} / July / 4});
+            check_info(zone, dst_end(y) - 1s);
+            check_info(zone, dst_end(y));
+        }
+    }
+
+    // the nonexistent and ambiguous local times
+    const auto gap = zone.get_info(local_days{2015y / March / 8} + 2h + 30min);
+    assert(gap.result == local_info::nonexistent);
+    assert(gap.first.abbrev == "PST");
+    assert(gap.second.abbrev == "PDT");
+    assert(zone.to_sys(local_days{2015y / March / 8} + 2h + 30min, choose::latest) == dst_start(2015));
+
+    const auto overlap = zone.get_info(local_days{2015y / November / 1} + 1h + 30min);
+    assert(overlap.result == local_info::ambiguous);
+    assert(overlap.first.abbrev == "PDT");
+    assert(overlap.second.abbrev == "PST");
+
+    assert(zone.to_sys(local_days{2015y / July / 4} + 12h) == sys_days{2015y / July / 4} + 19h);
+}
+
+void test_after_cache_is_full(const time_zone& zone) {
+    // far more intervals than the cache holds; lookups that miss must still be answered
+    for (int y = 2008; y <= 2060; ++y) {
+        check_info(zone, sys_days{year{y} / January / 15});
+        check_info(zone, sys_days{year{y} / July / 15});
+    }
+
+    test_repeated_lookups(zone);
+}
+
+void test_concurrent_lookups(const time_zone& zone) {
+    vector<jthread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&zone, t] {
+            for (int i = 0; i < 2000; ++i) {
+                const int y = 2010 + (i * 7 + t) % 40;
+                check_info(zone, sys_days{year{y} / month{static_cast<unsigned int>(1 + (i + t) % 12)} / 20} + 1h);
+                check_info(zone, dst_start(y));
+                check_info(zone, dst_end(y) - 1s);
+            }
+        });
+    }
+}
+
+int main() {
+    const auto& db = get_tzdb();
+    test_concurrent_lookups(*db.locate_zone("America/Los_Angeles"));
+    test_repeated_lookups(*db.locate_zone("America/Los_Angeles"));
+    test_after_cache_is_full(*db.locate_zone("America/Los_Angeles"));
+}
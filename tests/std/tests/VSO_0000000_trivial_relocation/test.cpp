@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define STATIC_ASSERT(...) static_assert(__VA_ARGS__, #__VA_ARGS__)
+
+using namespace std;
+
+int live_objects = 0;
+int moves        = 0;
+
+class relocatable { // opts in to trivial relocation; counts moves to detect whether they were avoided
+public:
+    explicit relocatable(int v) : val(v) {
+        ++live_objects;
+    }
+    relocatable(const relocatable& other) : val(other.val) {
+        ++live_objects;
+    }
+    relocatable(relocatable&& other) noexcept : val(other.val) {
+        ++live_objects;
+        ++moves;
+    }
+    relocatable& operator=(const relocatable& other) {
+        val = other.val;
+        return *this;
+    }
+    relocatable& operator=(relocatable&& other) noexcept {
+        val = other.val;
+        ++moves;
+        return *this;
+    }
+    ~relocatable() {
+        --live_objects;
+    }
+
+    int value() const {
+        return val;
+    }
+
+private:
+    int val;
+};
+
+namespace stdext {
+    template <>
+    constexpr bool enable_trivial_relocation<relocatable> = true;
+} // namespace stdext
+
+class not_relocatable { // points into itself, so it cannot be relocated by memcpy
+public:
+    explicit not_relocatable(int v) : val(v), self(this) {}
+    not_relocatable(const not_relocatable& other) : val(other.val), self(this) {}
+    not_relocatable& operator=(const not_relocatable& other) {
+        val = other.val;
+        return *this;
+    }
+
+    int value() const {
+        assert(self == this);
+        return val;
+    }
+
+private:
+    int val;
+    not_relocatable* self;
+};
+
+STATIC_ASSERT(_Is_trivially_relocatable<int>::value);
+STATIC_ASSERT(_Is_trivially_relocatable<relocatable>::value);
+STATIC_ASSERT(!_Is_trivially_relocatable<not_relocatable>::value);
+STATIC_ASSERT(_Is_trivially_relocatable<unique_ptr<int>>::value);
+STATIC_ASSERT(_Is_trivially_relocatable<unique_ptr<int[]>>::value);
+STATIC_ASSERT(_Is_trivially_relocatable<shared_ptr<int>>::value);
+STATIC_ASSERT(_Is_trivially_relocatable<weak_ptr<int>>::value);
+#if _ITERATOR_DEBUG_LEVEL == 0
+STATIC_ASSERT(_Is_trivially_relocatable<vector<int>>::value);
+#endif // _ITERATOR_DEBUG_LEVEL == 0
+
+template <class T>
+void check_values(const vector<T>& v, const vector<int>& expected) {
+    assert(v.size() == expected.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        assert(v[i].value() == expected[i]);
+    }
+}
+
+void test_relocatable() {
+    {
+        vector<relocatable> v;
+        vector<int> expected;
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back(i);
+            expected.push_back(i);
+        }
+        assert(moves == 0);
+        assert(live_objects == 100);
+        check_values(v, expected);
+
+        v.emplace(v.begin() + 10, -1);
+        expected.insert(expected.begin() + 10, -1);
+        check_values(v, expected);
+        moves = 0;
+
+        v.shrink_to_fit();
+        v.reserve(v.capacity() * 2);
+        v.resize(v.capacity() + 1, relocatable{42});
+        expected.resize(v.size(), 42);
+        assert(moves == 0);
+        assert(live_objects == static_cast<int>(v.size()));
+        check_values(v, expected);
+
+        v.erase(v.begin() + 5);
+        expected.erase(expected.begin() + 5);
+        v.erase(v.begin(), v.begin() + 20);
+        expected.erase(expected.begin(), expected.begin() + 20);
+        assert(moves == 0);
+        assert(live_objects == static_cast<int>(v.size()));
+        check_values(v, expected);
+
+        const relocatable values[] = {relocatable{7}, relocatable{8}, relocatable{9}};
+        v.shrink_to_fit();
+        v.insert(v.begin() + 3, begin(values), end(values));
+        expected.insert(expected.begin() + 3, {7, 8, 9});
+        check_values(v, expected);
+    }
+    assert(live_objects == 0);
+}
+
+void test_not_relocatable() {
+    vector<not_relocatable> v;
+    vector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i);
+        expected.push_back(i);
+    }
+    check_values(v, expected);
+
+    v.erase(v.begin() + 5, v.begin() + 10);
+    expected.erase(expected.begin() + 5, expected.begin() + 10);
+    v.shrink_to_fit();
+    v.emplace(v.begin(), -1);
+    expected.insert(expected.begin(), -1);
+    check_values(v, expected);
+}
+
+void test_library_types() {
+    vector<unique_ptr<int>> ptrs;
+    vector<string> strs;
+    for (int i = 0; i < 100; ++i) {
+        ptrs.push_back(make_unique<int>(i));
+        strs.push_back(to_string(i));
+        strs.push_back(string(40, static_cast<char>('a' + i % 26))); // not small
+    }
+
+    ptrs.erase(ptrs.begin() + 1);
+    strs.erase(strs.begin(), strs.begin() + 2);
+    ptrs.shrink_to_fit();
+    strs.shrink_to_fit();
+    ptrs.insert(ptrs.begin(), make_unique<int>(-1));
+    strs.insert(strs.begin(), "zero");
+
+    assert(*ptrs[0] == -1);
+    assert(*ptrs[1] == 0);
+    assert(*ptrs[2] == 2);
+    assert(*ptrs.back() == 99);
+    assert(strs[0] == "zero");
+    assert(strs[1] == "1");
+    assert(strs[2] == string(40, 'b'));
+    assert(strs.back() == string(40, static_cast<char>('a' + 99 % 26)));
+}
+
+int main() {
+    test_relocatable();
+    test_not_relocatable();
+    test_library_types();
+}
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#define _STD_TZDB_NAME_INDEX 1
+
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
+#include <string_view>
+
+using namespace std;
+using namespace std::chrono;
+
+// what locate_zone should find, by searching the vectors
+const time_zone* locate_without_index(const tzdb& db, const string_view name) {
+    for (const auto& zone : db.zones) {
+        if (zone.name() == name) {
+            return &zone;
+        }
+    }
+
+    for (const auto& link : db.links) {
+        if (link.name() == name) {
+            return locate_without_index(db, link.target());
+        }
+    }
+
+    return nullptr;
+}
+
+void test_every_name(const tzdb& db) {
+    for (const auto& zone : db.zones) {
+        assert(db.locate_zone(zone.name()) == &zone);
+    }
+
+    for (const auto& link : db.links) {
+        const auto zone = db.locate_zone(link.name());
+        assert(zone->name() == link.target());
+        assert(zone == locate_without_index(db, link.name()));
+    }
+
+    assert(db.locate_zone("America/Los_Angeles")->name() == "America/Los_Angeles");
+    assert(db.locate_zone("US/Pacific") == db.locate_zone("America/Los_Angeles"));
+    assert(db.current_zone() == db.locate_zone(db.current_zone()->name()));
+}
+
+void test_missing_names(const tzdb& db) {
+    constexpr string_view missing_names[]{
+        "", "Not/A_Zone", "America/Los_Angele", "America/Los_Angeles ", "america/los_angeles"};
+    for (const auto name : missing_names) {
+        try {
+            (void) db.locate_zone(name);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+    }
+}
+
+int main() {
+    const auto& db = get_tzdb();
+    test_every_name(db);
+    test_missing_names(db);
+
+    const auto& reloaded = reload_tzdb();
+    test_every_name(reloaded);
+    test_missing_names(reloaded);
+}
@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#pragma warning(push) // TRANSITION, OS-23694920
+#pragma warning(disable : 4668) // 'MEOW' is not defined as a preprocessor macro, replacing with '0' for '#if/#elif'
+#include <Windows.h>
+#pragma warning(pop)
+
+using namespace std;
+using namespace std::chrono;
+
+// Builds a database directory holding one zone, Test/Zone:
+//     +01:00 "AAA" until 2000-01-01T00:00Z,
+//     then +02:00 "XST" with daylight saving time as +03:00 "XDT" from the last Sunday in March at 02:00 local time
+//     to the last Sunday in October at 03:00 local time, like Europe/Helsinki; only the footer describes that rule.
+
+void append_be(string& out, const int64_t value, const int bytes) {
+    for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+void append_header(string& out, const int timecnt, const int typecnt, const int charcnt) {
+    out += "TZif2";
+    out.append(15, '\0');
+    append_be(out, 0, 4); // isutcnt
+    append_be(out, 0, 4); // isstdcnt
+    append_be(out, 0, 4); // leapcnt
+    append_be(out, timecnt, 4);
+    append_be(out, typecnt, 4);
+    append_be(out, charcnt, 4);
+}
+
+string make_tzif() {
+    string out;
+
+    // version 1 data block, which readers of version 2 files skip
+    append_header(out, 0, 1, 4);
+    append_be(out, 0, 4);
+    out += '\0';
+    out += '\0';
+    out.append("UTC", 4);
+
+    append_header(out, 1, 2, 8);
+    append_be(out, 946'684'800, 8); // 2000-01-01T00:00Z
+    out += '\1';
+    append_be(out, 3600, 4);
+    out += '\0';
+    out += '\0';
+    append_be(out, 7200, 4);
+    out += '\0';
+    out += '\4';
+    out.append("AAA\0XST", 8);
+    out += "\nXST-2XDT,M3.5.0,M10.5.0/3\n";
+    return out;
+}
+
+void write_file(const filesystem::path& path, const string_view contents) {
+    ofstream file{path, ios::binary};
+    file.write(contents.data(), static_cast<streamsize>(contents.size()));
+    assert(file);
+}
+
+void test_names(const tzdb& db) {
+    assert(db.version == "2099z");
+    assert(db.zones.size() == 2);
+
+    const auto zone = db.locate_zone("Test/Zone");
+    assert(zone->name() == "Test/Zone");
+    assert(db.locate_zone("Test/Link") == zone);
+    assert(db.locate_zone("Test/Chain") == zone); // a link to a link
+
+    assert(db.links.size() == 2);
+    for (const auto& link : db.links) {
+        assert(link.target() == "Test/Zone");
+    }
+}
+
+void test_transitions(const time_zone& zone) {
+    constexpr sys_seconds first_transition = sys_days{2000y / January / 1};
+    constexpr sys_seconds dst_start        = sys_days{2000y / March / 26}; // 02:00 XST
+    constexpr sys_seconds dst_end          = sys_days{2000y / October / 29}; // 03:00 XDT
+
+    auto info = zone.get_info(first_transition - 1s);
+    assert(info.begin == time_zone::_Min_seconds);
+    assert(info.end == first_transition);
+    assert(info.offset == 1h);
+    assert(info.save == 0min);
+    assert(info.abbrev == "AAA");
+
+    // from the transition table to the footer's rule
+    info = zone.get_info(first_transition);
+    assert(info.begin == first_transition);
+    assert(info.end == dst_start);
+    assert(info.offset == 2h);
+    assert(info.save == 0min);
+    assert(info.abbrev == "XST");
+
+    info = zone.get_info(sys_days{2000y / July / 1});
+    assert(info.begin == dst_start);
+    assert(info.end == dst_end);
+    assert(info.offset == 3h);
+    assert(info.save == 60min);
+    assert(info.abbrev == "XDT");
+
+    info = zone.get_info(sys_days{2100y / December / 31});
+    assert(info.begin == sys_days{2100y / October / 31});
+    assert(info.end == sys_days{2101y / March / 27});
+    assert(info.offset == 2h);
+    assert(info.abbrev == "XST");
+
+    // the nonexistent and ambiguous local times around the footer's changes
+    const auto gap = zone.get_info(local_days{2000y / March / 26} + 2h + 30min);
+    assert(gap.result == local_info::nonexistent);
+    assert(gap.first.abbrev == "XST");
+    assert(gap.second.abbrev == "XDT");
+
+    const auto overlap = zone.get_info(local_days{2000y / October / 29} + 2h + 30min);
+    assert(overlap.result == local_info::ambiguous);
+    assert(overlap.first.abbrev == "XDT");
+    assert(overlap.second.abbrev == "XST");
+
+    const auto noon = local_days{2000y / July / 1} + 12h;
+    assert(zone.to_sys(noon) == sys_days{2000y / July / 1} + 9h);
+    assert(zone.to_local(zone.to_sys(noon)) == noon);
+}
+
+void test_malformed_zone(const tzdb& db) {
+    // a zone whose file isn't TZif data is found by name, but reading its transitions fails
+    const auto zone = db.locate_zone("Test/Broken");
+    try {
+        (void) zone->get_info(sys_days{2000y / January / 1});
+        assert(false);
+    } catch (const system_error& e) {
+        assert(e.code() == error_code(ERROR_INVALID_DATA, system_category()));
+    }
+}
+
+int main() {
+    const auto dir = filesystem::temp_directory_path() / "VSO_0000000_tzdb_tzif_backend";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir / "Test");
+    write_file(dir / "tzdata.zi", "# version 2099z\n"
+                                  "# only the zone and link lines matter\n"
+                                  "Z Test/Broken 0 - BBB\n"
+                                  "Z Test/Zone 1 - AAA 2000\n"
+                                  "2 Test XS%sT\n"
+                                  "L Test/Link Test/Chain\n"
+                                  "L Test/Zone Test/Link\n");
+    write_file(dir / "Test" / "Zone", make_tzif());
+    write_file(dir / "Test" / "Broken", "not TZif data");
+
+    // must happen before anything reads the time zone database
+    assert(_putenv_s("TZDIR", dir.string().c_str()) == 0);
+
+    const auto& db = get_tzdb();
+    test_names(db);
+    test_transitions(*db.locate_zone("Test/Zone"));
+    test_malformed_zone(db);
+
+    filesystem::remove_all(dir);
+}
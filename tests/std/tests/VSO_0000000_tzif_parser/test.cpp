@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Checks the parser behind the TZDIR backend of the time zone database against a real compiled database: the
+// directory named on the command line, or else /usr/share/zoneinfo. tzif.hpp uses only the Standard Library, so this
+// test also builds with other implementations, for example with GCC on Linux against the system's zoneinfo.
+
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#ifndef _STD // not the MSVC STL
+#define _STD ::std::
+#endif // !defined(_STD)
+
+#include "../../../../stl/src/tzif.hpp"
+
+using namespace std;
+
+constexpr int64_t year_1900 = -2'208'988'800;
+constexpr int64_t year_2100 = 4'102'444'800;
+
+void assert_period(const _Tzif_period& period, const int64_t begin, const int64_t end, const int32_t utoff,
+    const int32_t save, const string_view abbrev) {
+    assert(period._Begin == begin);
+    assert(period._End == end);
+    assert(period._Type->_Utoff == utoff);
+    assert(period._Save == save);
+    assert(period._Type->_Abbrev == abbrev);
+}
+
+_Tzif_zone footer_only_zone(const string_view rule) {
+    _Tzif_zone zone;
+    zone._Types.resize(1);
+    zone._Has_footer = true;
+    const bool parsed = _Parse_posix_tz(rule, zone._Footer);
+    assert(parsed);
+    return zone;
+}
+
+void test_posix_tz() {
+    _Tzif_posix_tz tz;
+    assert(_Parse_posix_tz("EST5EDT,M3.2.0,M11.1.0", tz));
+    assert(tz._Std._Utoff == -18'000 && tz._Std._Abbrev == "EST" && !tz._Std._Is_dst);
+    assert(tz._Has_dst && tz._Dst._Utoff == -14'400 && tz._Dst._Abbrev == "EDT" && tz._Dst._Is_dst);
+    assert(tz._Start._Kind == 'M' && tz._Start._Month == 3 && tz._Start._Week == 2 && tz._Start._Day == 0);
+    assert(tz._End._Kind == 'M' && tz._End._Month == 11 && tz._End._Week == 1 && tz._End._Time == 7200);
+
+    tz = {};
+    assert(_Parse_posix_tz("<+0330>-3:30", tz));
+    assert(tz._Std._Utoff == 12'600 && tz._Std._Abbrev == "+0330" && !tz._Has_dst);
+
+    tz = {};
+    assert(_Parse_posix_tz("<-03>3<-02>,M3.5.0/-2,M10.5.0/-1", tz));
+    assert(tz._Std._Utoff == -10'800 && tz._Dst._Utoff == -7200 && tz._Start._Time == -7200);
+
+    for (const auto bad : {"", "EST", "E5", "EST5EDT,M13.1.0,M11.1.0", "EST5EDT,M3.2.0", "EST5EDT,M3.2.0,M11.1.0x",
+             "<+03", "EST25", "EST5EDT,J0,J365"}) {
+        tz = {};
+        assert(!_Parse_posix_tz(bad, tz));
+    }
+
+    // America/New_York's rule, in 2021 and in 2100; the expected values come from Python's zoneinfo
+    const auto new_york = footer_only_zone("EST5EDT,M3.2.0,M11.1.0");
+    assert_period(_Tzif_find_period(new_york, 1'615'705'199), 1'604'210'400, 1'615'705'200, -18'000, 0, "EST");
+    assert_period(_Tzif_find_period(new_york, 1'615'705'200), 1'615'705'200, 1'636'264'800, -14'400, 3600, "EDT");
+    assert_period(_Tzif_find_period(new_york, 4'108'690'800), 4'108'690'800, 4'129'250'400, -14'400, 3600, "EDT");
+
+    // Europe/Dublin's rule, where winter is the negative daylight saving time
+    const auto dublin = footer_only_zone("IST-1GMT0,M10.5.0,M3.5.0/1");
+    assert_period(_Tzif_find_period(dublin, 1'642'204'800), 1'635'642'000, 1'648'342'800, 0, -3600, "GMT");
+
+    // daylight saving time all year
+    const auto permanent = footer_only_zone("XST3XDT,J1/0,J365/25");
+    const auto all_year  = _Tzif_find_period(permanent, 1'642'204'800);
+    assert(all_year._Type->_Is_dst && all_year._Save == 3600);
+}
+
+[[nodiscard]] bool read_file(const filesystem::path& path, string& contents) {
+    ifstream file{path, ios::binary};
+    contents.assign(istreambuf_iterator<char>{file}, istreambuf_iterator<char>{});
+    return !file.bad();
+}
+
+[[nodiscard]] _Tzif_zone load_zone(const filesystem::path& path) {
+    string data;
+    _Tzif_zone zone;
+    const bool parsed = read_file(path, data) && _Parse_tzif(data, zone);
+    assert(parsed);
+    return zone;
+}
+
+void check_zone(const _Tzif_zone& zone) {
+    // periods tile the timeline, and those from the table have the types that the file gives them
+    for (int64_t time = year_1900; time < year_2100;) {
+        const auto period = _Tzif_find_period(zone, time);
+        assert(period._Begin <= time && time < period._End);
+        assert((period._Save != 0) == period._Type->_Is_dst);
+        if (period._End != _Tzif_max_time) {
+            assert(_Tzif_find_period(zone, period._End)._Begin == period._End);
+        }
+
+        time = period._End;
+    }
+
+    const auto& transitions = zone._Transitions;
+    for (size_t idx = 0; idx < transitions.size(); ++idx) {
+        if (idx + 1 < transitions.size() && transitions[idx + 1] == transitions[idx]) {
+            continue; // only the last of simultaneous transitions takes effect
+        }
+
+        // at the last transition, the footer takes over, and it must agree with the table
+        const auto period = _Tzif_find_period(zone, transitions[idx]);
+        const auto& type  = zone._Types[zone._Transition_types[idx]];
+        assert(period._Begin == transitions[idx]);
+        assert(period._Type->_Utoff == type._Utoff && period._Type->_Is_dst == type._Is_dst);
+        assert(period._Type->_Abbrev == type._Abbrev);
+    }
+}
+
+void test_known_zones(const filesystem::path& root) {
+    // the expected values come from Python's zoneinfo
+    const auto new_york = load_zone(root / "America" / "New_York");
+    assert_period(_Tzif_find_period(new_york, 1'615'705'199), 1'604'210'400, 1'615'705'200, -18'000, 0, "EST");
+    assert_period(_Tzif_find_period(new_york, 1'615'705'200), 1'615'705'200, 1'636'264'800, -14'400, 3600, "EDT");
+    assert_period(_Tzif_find_period(new_york, 4'129'250'399), 4'108'690'800, 4'129'250'400, -14'400, 3600, "EDT");
+
+    // half an hour of daylight saving time
+    const auto lord_howe = load_zone(root / "Australia" / "Lord_Howe");
+    const auto summer    = _Tzif_find_period(lord_howe, 1'640'995'200);
+    assert(summer._Type->_Utoff == 39'600 && summer._Save == 1800 && summer._Type->_Abbrev == "+11");
+
+    const auto kolkata = load_zone(root / "Asia" / "Kolkata");
+    assert_period(_Tzif_find_period(kolkata, 1'640'995'200), -764'145'000, _Tzif_max_time, 19'800, 0, "IST");
+
+    const auto utc = load_zone(root / "UTC");
+    assert_period(_Tzif_find_period(utc, 0), _Tzif_min_time, _Tzif_max_time, 0, 0, "UTC");
+}
+
+void test_all_zones(const filesystem::path& root) {
+    size_t zones = 0;
+    for (auto it = filesystem::recursive_directory_iterator{root}; it != filesystem::recursive_directory_iterator{};
+         ++it) {
+        if (it->is_directory() && (it->path().filename() == "right" || it->path().filename() == "posix")) {
+            it.disable_recursion_pending(); // leap seconds aren't supported, and posix/ repeats the other zones
+            continue;
+        }
+
+        string data;
+        if (!it->is_regular_file() || !read_file(it->path(), data) || data.compare(0, 4, "TZif") != 0) {
+            continue; // tzdata.zi, zone.tab, and so on
+        }
+
+        _Tzif_zone zone;
+        const bool parsed = _Parse_tzif(data, zone);
+        assert(parsed);
+        check_zone(zone);
+        ++zones;
+    }
+
+    assert(zones > 300);
+}
+
+int main(int argc, char* argv[]) {
+    test_posix_tz();
+
+    const filesystem::path root{argc > 1 ? argv[1] : "/usr/share/zoneinfo"};
+    error_code ec;
+    if (!filesystem::exists(root / "America" / "New_York", ec)) {
+        return 0; // no compiled time zone database to check
+    }
+
+    test_known_zones(root);
+    test_all_zones(root);
+}
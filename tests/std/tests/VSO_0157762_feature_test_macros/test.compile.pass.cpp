@@ -495,6 +495,12 @@ STATIC_ASSERT(__cpp_lib_has_unique_object_representations == 201606L);
 #error __cpp_lib_has_unique_object_representations is defined
 #endif
 
+#if _HAS_CXX26
+STATIC_ASSERT(__cpp_lib_hazard_pointer == 202306L);
+#elif defined(__cpp_lib_hazard_pointer)
+#error __cpp_lib_hazard_pointer is defined
+#endif
+
 #if _HAS_CXX17
 STATIC_ASSERT(__cpp_lib_hypot == 201603L);
 #elif defined(__cpp_lib_hypot)
@@ -505,6 +511,12 @@ STATIC_ASSERT(__cpp_lib_incomplete_container_elements == 201505L);
 
 STATIC_ASSERT(__cpp_lib_initializer_list == 202511L);
 
+#if _HAS_CXX26
+STATIC_ASSERT(__cpp_lib_inplace_vector == 202406L);
+#elif defined(__cpp_lib_inplace_vector)
+#error __cpp_lib_inplace_vector is defined
+#endif
+
 #if _HAS_CXX20
 STATIC_ASSERT(__cpp_lib_int_pow2 == 202002L);
 #elif defined(__cpp_lib_int_pow2)
@@ -847,6 +859,12 @@ STATIC_ASSERT(__cpp_lib_raw_memory_algorithms == 201606L);
 #error __cpp_lib_raw_memory_algorithms is defined
 #endif
 
+#if _HAS_CXX26
+STATIC_ASSERT(__cpp_lib_rcu == 202306L);
+#elif defined(__cpp_lib_rcu)
+#error __cpp_lib_rcu is defined
+#endif
+
 #if _HAS_CXX23
 STATIC_ASSERT(__cpp_lib_reference_from_temporary == 202202L);
 #elif defined(__cpp_lib_reference_from_temporary)